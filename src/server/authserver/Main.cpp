@@ -34,11 +34,14 @@
 #include "SignalHandler.h"
 #include "RealmList.h"
 #include "RealmAcceptor.h"
+#include "AuthWorkerPool.h"
+#include "OpenSSLCrypto.h"
 
 #include <ace/Dev_Poll_Reactor.h>
 #include <ace/TP_Reactor.h>
 #include <ace/ACE.h>
 #include <ace/Sig_Handler.h>
+#include <ace/OS_NS_unistd.h>
 
 #include <openssl/opensslv.h>
 #include <openssl/crypto.h>
@@ -61,7 +64,7 @@ char serviceDescription[] = "Massive Network Game Object Server";
 int m_ServiceStatus = -1;
 #endif
 
-bool StartDB();
+bool StartDB(uint32 authWorkerThreads);
 
 bool stopEvent = false;                                     ///< Setting it to true stops the server
 
@@ -200,8 +203,13 @@ extern int main(int argc, char **argv)
         sLog->outString("Daemon PID: %u\n", pid);
     }
 
+    ///- Logins are handled by the auth worker threads, 0 means one per processor
+    int authWorkerThreads = sConfig->GetIntDefault("AuthWorkerThreads", 0);
+    if (authWorkerThreads <= 0)
+        authWorkerThreads = std::max<int>(int(ACE_OS::num_processors_online()), 1);
+
     ///- Initialize the database connection
-    if (!StartDB())
+    if (!StartDB(uint32(authWorkerThreads)))
         return 1;
 
     ///- Initialize the log database
@@ -217,6 +225,11 @@ extern int main(int argc, char **argv)
         return 1;
     }
 
+    ///- The workers run SRP6 (BN_rand) concurrently, OpenSSL older than 1.1 needs locking callbacks for that
+    OpenSSLCrypto::threadsSetup();
+
+    sAuthWorkerPool->Start(uint32(authWorkerThreads), ACE_Reactor::instance());
+
     ///- Launch the listening network socket
     RealmAcceptor acceptor;
 
@@ -325,6 +338,9 @@ extern int main(int argc, char **argv)
 #endif
     }
 
+    sAuthWorkerPool->Stop();
+    OpenSSLCrypto::threadsCleanup();
+
     ///- Close the Database Pool
     LoginDatabase.Close();
 
@@ -333,7 +349,7 @@ extern int main(int argc, char **argv)
 }
 
 /// Initialize connection to the database
-bool StartDB()
+bool StartDB(uint32 authWorkerThreads)
 {
     std::string dbstring = sConfig->GetStringDefault("LoginDatabaseInfo", "");
     if (dbstring.empty())
@@ -356,7 +372,13 @@ bool StartDB()
         synch_threads = 1;
     }
 
-    /// NOTE: While authserver is singlethreaded you should keep synch_threads == 1. Increasing it is just silly since only 1 will be used ever.
+    /// Every auth worker thread runs synchronous queries, give each one its own connection
+    if (synch_threads < authWorkerThreads)
+    {
+        sLog->outDetail("Raising LoginDatabase.SynchThreads to %u, one connection per auth worker thread.", authWorkerThreads);
+        synch_threads = uint8(std::min<uint32>(authWorkerThreads, 32));
+    }
+
     if (!LoginDatabase.Open(dbstring.c_str(), worker_threads, synch_threads))
     {
         sLog->outError("Cannot connect to database");
@@ -32,6 +32,7 @@
 #include "RealmList.h"
 #include "AuthSocket.h"
 #include "AuthCodes.h"
+#include "AuthWorkerPool.h"
 #include <openssl/md5.h>
 #include "SHA1.h"
 //#include "Util.h" -- for commented utf8ToUpperOnlyLatin
@@ -223,6 +224,10 @@ AuthSocket::AuthSocket(RealmSocket& socket) : socket_(socket)
 
     _authPacketTime = 0;
     _authPacketCount = 0;
+
+    _taskPending = false;
+    _taskShutdown = false;
+    _closed = false;
 }
 
 /// Close patch file descriptor before leaving
@@ -239,6 +244,7 @@ void AuthSocket::OnAccept(void)
 void AuthSocket::OnClose(void)
 {
     sLog->outDebug("AuthSocket::OnClose");
+    _closed = true;
 }
 
 /// Read the packet from the client
@@ -249,6 +255,10 @@ void AuthSocket::OnRead()
     uint8 _cmd;
     while (1)
     {
+        // the next packet is handled once the running task has finished
+        if (_taskPending)
+            return;
+
         if (!socket().recv_soft((char *)&_cmd, 1))
             return;
 
@@ -309,6 +319,39 @@ void AuthSocket::OnRead()
     }
 }
 
+/// Hand a login step over to the auth worker threads
+void AuthSocket::_QueueTask(void (AuthSocket::*task)())
+{
+    _taskPending = true;
+    _taskShutdown = false;
+    _taskResponse.clear();
+
+    // the socket must outlive the task, even if the client disconnects meanwhile
+    socket().add_reference();
+    sAuthWorkerPool->Queue(this, task);
+}
+
+void AuthSocket::_FinishTask()
+{
+    _taskPending = false;
+
+    if (!_closed)
+    {
+        if (_taskResponse.size())
+            socket().send((char const*)_taskResponse.contents(), _taskResponse.size());
+
+        if (_taskShutdown)
+            socket().shutdown();
+        else
+            OnRead();                                       // packets received while the task was running
+    }
+
+    _taskResponse.clear();
+
+    // may delete this
+    socket().remove_reference();
+}
+
 /// Make the SRP6 calculation from hash in dB
 void AuthSocket::_SetVSFields(const std::string& rI)
 {
@@ -392,8 +435,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->ip);
 #endif
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
     _expversion = (AuthHelper::IsPostWotLKAcceptedClientBuild(_build) ? POST_WOTLK_EXP_FLAG : NO_VALID_EXP_FLAG) |
@@ -402,6 +443,19 @@ bool AuthSocket::_HandleLogonChallenge()
 
     _build = ch->build;
 
+    _localizationName.resize(4);
+    for (int i = 0; i < 4; ++i)
+        _localizationName[i] = ch->country[4-i-1];
+
+    _QueueTask(&AuthSocket::_LogonChallengeTask);
+    return true;
+}
+
+/// Logon Challenge database checks and SRP6 setup, runs on an auth worker thread
+void AuthSocket::_LogonChallengeTask()
+{
+    ByteBuffer& pkt = _taskResponse;
+
     pkt << (uint8) AUTH_LOGON_CHALLENGE;
     pkt << (uint8) 0x00;
 
@@ -534,20 +588,13 @@ bool AuthSocket::_HandleLogonChallenge()
                     uint8 secLevel = fields[4].GetUInt8();
                     _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
 
-                    _localizationName.resize(4);
-                    for (int i = 0; i < 4; ++i)
-                        _localizationName[i] = ch->country[4-i-1];
-
-                    sLog->outBasic("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str (), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
+                    sLog->outBasic("[AuthChallenge] account %s is using '%s' locale (%u)", _login.c_str (), _localizationName.c_str(), GetLocaleByName(_localizationName));
                 }
             }
         }
         else                                            //no account
             pkt << (uint8)WOW_FAIL_UNKNOWN_ACCOUNT;
     }
-
-    socket().send((char const*)pkt.contents(), pkt.size());
-    return true;
 }
 
 /// Logon Proof command handler
@@ -573,8 +620,6 @@ bool AuthSocket::_HandleLogonProof()
     }
 
     // Continue the SRP6 calculation based on data received from the client
-    BigNumber A;
-
     A.SetBinary(lp.A, 32);
 
     // SRP safeguard: abort if A == 0
@@ -584,6 +629,15 @@ bool AuthSocket::_HandleLogonProof()
         return true;
     }
 
+    memcpy(_M1, lp.M1, 20);
+
+    _QueueTask(&AuthSocket::_LogonProofTask);
+    return true;
+}
+
+/// Logon Proof SRP6 verification and database updates, runs on an auth worker thread
+void AuthSocket::_LogonProofTask()
+{
     SHA1Hash sha;
     sha.UpdateBigNumbers(&A, &B, NULL);
     sha.Finalize();
@@ -642,7 +696,7 @@ bool AuthSocket::_HandleLogonProof()
     M.SetBinary(sha.GetDigest(), 20);
 
     // Check if SRP6 results match (password is correct), else send an error
-    if (!memcmp(M.AsByteArray(), lp.M1, 20))
+    if (!memcmp(M.AsByteArray(), _M1, 20))
     {
         sLog->outBasic("User '%s' successfully authenticated", _login.c_str());
 
@@ -672,7 +726,7 @@ bool AuthSocket::_HandleLogonProof()
             proof.unk1 = 0x00800000;
             proof.unk2 = 0x00;
             proof.unk3 = 0x00;
-            socket().send((char *)&proof, sizeof(proof));
+            _taskResponse.append((uint8 const*)&proof, sizeof(proof));
         }
         else
         {
@@ -681,15 +735,15 @@ bool AuthSocket::_HandleLogonProof()
             proof.cmd = AUTH_LOGON_PROOF;
             proof.error = 0;
             proof.unk2 = 0x00;
-            socket().send((char *)&proof, sizeof(proof));
+            _taskResponse.append((uint8 const*)&proof, sizeof(proof));
         }
 
         _status = STATUS_AUTHED;
     }
     else
     {
-        char data[4]= { AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT, 3, 0};
-        socket().send(data, sizeof(data));
+        uint8 data[4]= { AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT, 3, 0};
+        _taskResponse.append(data, sizeof(data));
         
         sLog->outBasic("[AuthChallenge] account %s tried to login with wrong password!",_login.c_str ());
 
@@ -738,8 +792,6 @@ bool AuthSocket::_HandleLogonProof()
             }
         }
     }
-
-    return true;
 }
 
 /// Reconnect Challenge command handler
@@ -778,6 +830,13 @@ bool AuthSocket::_HandleReconnectChallenge()
 
     _login = (const char*)ch->I;
 
+    _QueueTask(&AuthSocket::_ReconnectChallengeTask);
+    return true;
+}
+
+/// Reconnect Challenge session key lookup, runs on an auth worker thread
+void AuthSocket::_ReconnectChallengeTask()
+{
     PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_GET_SESSIONKEY);
     stmt->setString(0, _login);
     PreparedQueryResult result = LoginDatabase.Query(stmt);
@@ -786,8 +845,8 @@ bool AuthSocket::_HandleReconnectChallenge()
     if (!result)
     {
         sLog->outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", _login.c_str());
-        socket().shutdown();
-        return false;
+        _taskShutdown = true;
+        return;
     }
 
     K.SetHexStr ((*result)[0].GetCString());
@@ -795,14 +854,12 @@ bool AuthSocket::_HandleReconnectChallenge()
     _status = STATUS_RECONNECT_PROOF;
 
     // Sending response
-    ByteBuffer pkt;
+    ByteBuffer& pkt = _taskResponse;
     pkt << (uint8)AUTH_RECONNECT_CHALLENGE;
     pkt << (uint8)0x00;
     _reconnectProof.SetRand(16 * 8);
     pkt.append(_reconnectProof.AsByteArray(16), 16);             // 16 bytes random
     pkt << (uint64)0x00 << (uint64)0x00;                  // 16 bytes zeros
-    socket().send((char const*)pkt.contents(), pkt.size());
-    return true;
 }
 
 /// Reconnect Proof command handler
@@ -29,6 +29,7 @@
 
 #include "Common.h"
 #include "BigNumber.h"
+#include "ByteBuffer.h"
 
 #include "RealmSocket.h"
 
@@ -71,6 +72,9 @@ class AuthSocket: public RealmSocket::Session
 
         void _SetVSFields(const std::string& rI);
 
+        // reactor thread, sends the result of the finished task and reads on
+        void _FinishTask();
+
         FILE *pPatch;
         ACE_Thread_Mutex patcherLock;
 
@@ -78,13 +82,27 @@ class AuthSocket: public RealmSocket::Session
         RealmSocket& socket_;
         RealmSocket& socket(void) { return socket_; }
 
+        // The tasks run on an auth worker thread (see AuthWorkerPool) while the socket is not read,
+        // they must not touch the socket and write their answer to _taskResponse
+        void _QueueTask(void (AuthSocket::*task)());
+        void _LogonChallengeTask();
+        void _LogonProofTask();
+        void _ReconnectChallengeTask();
+
         BigNumber N, s, g, v;
         BigNumber b, B;
         BigNumber K;
         BigNumber _reconnectProof;
+        BigNumber A;
+        uint8 _M1[20];
 
         int _status;
 
+        ByteBuffer _taskResponse;
+        bool _taskPending;
+        bool _taskShutdown;                                 // shutdown the socket once the task is finished
+        bool _closed;
+
         time_t _authPacketTime;
         uint32 _authPacketCount;
 
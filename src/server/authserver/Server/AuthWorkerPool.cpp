@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://www.getmangos.com/>
+ *
+ * Copyright (C) 2008-2011 Trinity <http://www.trinitycore.org/>
+ *
+ * Copyright (C) 2010-2011 Project SkyFire <http://www.projectskyfire.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/** \file
+  \ingroup realmd
+  */
+
+#include "Common.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+#include "AuthWorkerPool.h"
+#include "AuthSocket.h"
+
+#include <ace/Method_Request.h>
+#include <ace/Reactor.h>
+#include <ace/Guard_T.h>
+
+class AuthWorkerPool::AuthTask : public ACE_Method_Request
+{
+    public:
+        AuthTask(AuthSocket* session, AuthTaskFunction task) : m_session(session), m_task(task) {}
+
+        virtual int call()
+        {
+            (m_session->*m_task)();
+            sAuthWorkerPool->Finished(m_session);
+            return 0;
+        }
+
+    private:
+        AuthSocket* m_session;
+        AuthTaskFunction m_task;
+};
+
+AuthWorkerPool::AuthWorkerPool(void) : m_threads(0)
+{
+}
+
+void AuthWorkerPool::Start(uint32 threads, ACE_Reactor* reactor)
+{
+    this->reactor(reactor);
+
+    if (threads && ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE, int(threads)) == -1)
+    {
+        sLog->outError("AuthWorkerPool: could not start %u threads, logins are handled on the network thread.", threads);
+        threads = 0;
+    }
+
+    m_threads = threads;
+    sLog->outString("Using %u auth worker threads", m_threads);
+}
+
+void AuthWorkerPool::Stop(void)
+{
+    if (!m_threads)
+        return;
+
+    m_queue.queue()->deactivate();
+    wait();
+    m_threads = 0;
+}
+
+void AuthWorkerPool::Queue(AuthSocket* session, AuthTaskFunction task)
+{
+    AuthTask* request = new AuthTask(session, task);
+    if (m_threads && m_queue.enqueue(request) != -1)
+        return;
+
+    request->call();
+    delete request;
+}
+
+int AuthWorkerPool::svc(void)
+{
+    MySQL::Thread_Init();
+
+    while (ACE_Method_Request* request = m_queue.dequeue())
+    {
+        request->call();
+        delete request;
+    }
+
+    MySQL::Thread_End();
+    return 0;
+}
+
+void AuthWorkerPool::Finished(AuthSocket* session)
+{
+    bool notify;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_finishedLock);
+
+        // one notification for all sessions finished before the reactor gets to them
+        notify = m_finished.empty();
+        m_finished.push_back(session);
+    }
+
+    if (notify && reactor()->notify(this, ACE_Event_Handler::EXCEPT_MASK) == -1)
+        sLog->outError("AuthWorkerPool: reactor notification failed, finished logins wait for the next one");
+}
+
+int AuthWorkerPool::handle_exception(ACE_HANDLE)
+{
+    std::vector<AuthSocket*> finished;
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_finishedLock, 0);
+        finished.swap(m_finished);
+    }
+
+    for (std::vector<AuthSocket*>::const_iterator itr = finished.begin(); itr != finished.end(); ++itr)
+        (*itr)->_FinishTask();
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://www.getmangos.com/>
+ *
+ * Copyright (C) 2008-2011 Trinity <http://www.trinitycore.org/>
+ *
+ * Copyright (C) 2010-2011 Project SkyFire <http://www.projectskyfire.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/** \file
+  \ingroup realmd
+  */
+
+#ifndef __AUTHWORKERPOOL_H__
+#define __AUTHWORKERPOOL_H__
+
+#include <ace/Task.h>
+#include <ace/Activation_Queue.h>
+#include <ace/Singleton.h>
+#include <ace/Null_Mutex.h>
+#include <ace/Thread_Mutex.h>
+
+#include "Define.h"
+
+#include <vector>
+
+class AuthSocket;
+
+typedef void (AuthSocket::*AuthTaskFunction)(void);
+
+/*
+ * Runs the login steps which query the database or do the SRP6 math on worker threads,
+ * so logins of different clients do not wait for each other. The sockets belong to the
+ * reactor thread: a finished task is handed back to it through a reactor notification
+ * and the session sends the result from there.
+ */
+class AuthWorkerPool : public ACE_Task_Base
+{
+    public:
+        // Null_Mutex is safe because the singleton is initialized before the acceptor is opened
+        static AuthWorkerPool* instance() { return ACE_Singleton<AuthWorkerPool, ACE_Null_Mutex>::instance(); }
+
+        AuthWorkerPool(void);
+        virtual ~AuthWorkerPool(void) {}
+
+        // without threads the tasks run on the reactor thread, as before
+        void Start(uint32 threads, ACE_Reactor* reactor);
+        void Stop(void);
+
+        void Queue(AuthSocket* session, AuthTaskFunction task);
+
+        virtual int svc(void);
+
+        // reactor thread, finishes the sessions whose task is done
+        virtual int handle_exception(ACE_HANDLE);
+
+    private:
+        void Finished(AuthSocket* session);
+
+        class AuthTask;
+
+        ACE_Activation_Queue m_queue;
+        ACE_Thread_Mutex m_finishedLock;
+        std::vector<AuthSocket*> m_finished;                // guarded by m_finishedLock
+        uint32 m_threads;
+};
+
+#define sAuthWorkerPool AuthWorkerPool::instance()
+
+#endif /* __AUTHWORKERPOOL_H__ */
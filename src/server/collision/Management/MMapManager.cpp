@@ -20,8 +20,105 @@
 #include "Log.h"
 #include "World.h"
 
+#include <ace/Guard_T.h>
+
 namespace MMAP
 {
+    // ######################## NavMeshQueryLease ########################
+    NavMeshQueryLease::NavMeshQueryLease(MMapManager* manager, uint32 mapId) : m_manager(manager), m_data(NULL), m_query(NULL)
+    {
+        if (!m_manager)
+            return;
+
+        // released by the destructor, tiles must not change while the query is used
+        m_manager->m_lock.acquire_read();
+
+        MMapDataSet::const_iterator itr = m_manager->loadedMMaps.find(mapId);
+        if (itr == m_manager->loadedMMaps.end())
+            return;
+
+        m_data = itr->second;
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_data->lock);
+            if (!m_data->freeQueries.empty())
+            {
+                m_query = m_data->freeQueries.back();
+                m_data->freeQueries.pop_back();
+                return;
+            }
+        }
+
+        // every thread searching this map at the same time needs one, so the pool stays at the number of map threads
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if (dtStatusFailed(query->init(m_data->navMesh, MMAP_QUERY_MAX_NODES)))
+        {
+            dtFreeNavMeshQuery(query);
+            sLog->outError("MMAP:NavMeshQueryLease: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+            return;
+        }
+
+        uint32 queryCount;
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_data->lock);
+            queryCount = ++m_data->queryCount;
+        }
+
+        m_query = query;
+        sLog->outDetail("MMAP:NavMeshQueryLease: created dtNavMeshQuery %u for mapId %03u", queryCount, mapId);
+    }
+
+    NavMeshQueryLease::~NavMeshQueryLease()
+    {
+        if (m_query)
+        {
+            ACE_Guard<ACE_Thread_Mutex> guard(m_data->lock);
+            m_data->freeQueries.push_back(m_query);
+        }
+
+        if (m_manager)
+            m_manager->m_lock.release();
+    }
+
+    static uint32 GetPathCacheSlot(dtPolyRef startPoly, dtPolyRef endPoly)
+    {
+        uint64 hash = uint64(startPoly) * UI64LIT(0x9E3779B97F4A7C15) ^ uint64(endPoly);
+        return uint32(hash ^ (hash >> 32)) & (MMAP_PATH_CACHE_SIZE - 1);
+    }
+
+    bool NavMeshQueryLease::GetCachedPath(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef* path, uint32& length, uint32 maxLength) const
+    {
+        if (!m_query)
+            return false;
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_data->lock, false);
+
+        MMapPathCacheEntry const& entry = m_data->pathCache[GetPathCacheSlot(startPoly, endPoly)];
+        if (entry.startPoly != startPoly || entry.endPoly != endPoly || entry.path.size() > maxLength ||
+            entry.includeFlags != filter.getIncludeFlags() || entry.excludeFlags != filter.getExcludeFlags())
+            return false;
+
+        length = uint32(entry.path.size());
+        memcpy(path, &entry.path[0], length * sizeof(dtPolyRef));
+        return true;
+    }
+
+    void NavMeshQueryLease::StoreCachedPath(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef const* path, uint32 length)
+    {
+        if (!m_query || !length)
+            return;
+
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_data->lock);
+
+        // a newer corridor replaces whatever used the slot before
+        MMapPathCacheEntry& entry = m_data->pathCache[GetPathCacheSlot(startPoly, endPoly)];
+        entry.startPoly = startPoly;
+        entry.endPoly = endPoly;
+        entry.includeFlags = filter.getIncludeFlags();
+        entry.excludeFlags = filter.getExcludeFlags();
+        entry.path.assign(path, path + length);
+    }
+
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
@@ -88,8 +185,22 @@ namespace MMAP
         return uint32(x << 16 | y);
     }
 
+    // corridors may lead over a tile which is gone or around one which was just added
+    void MMapManager::ClearPathCache(MMapData* mmap)
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, mmap->lock);
+
+        for (std::vector<MMapPathCacheEntry>::iterator itr = mmap->pathCache.begin(); itr != mmap->pathCache.end(); ++itr)
+        {
+            itr->startPoly = 0;
+            itr->endPoly = 0;
+        }
+    }
+
     bool MMapManager::loadMap(const std::string& /*basePath*/, uint32 mapId, int32 x, int32 y)
     {
+        TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, m_lock);
+
         // make sure the mmap is loaded and ready to load tiles
         if (!loadMapData(mapId))
             return false;
@@ -154,6 +265,7 @@ namespace MMAP
         {
             mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
+            ClearPathCache(mmap);
             sLog->outDetail("MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
             return true;
         }
@@ -169,6 +281,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     {
+        TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, m_lock);
+
         // check if we have this map loaded
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
         {
@@ -203,6 +317,7 @@ namespace MMAP
         {
             mmap->mmapLoadedTiles.erase(packedGridPos);
             --loadedTiles;
+            ClearPathCache(mmap);
             sLog->outDetail("MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
             return true;
         }
@@ -212,6 +327,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId)
     {
+        TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, m_lock);
+
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
         {
             // file may not exist, therefore not loaded
@@ -240,63 +357,4 @@ namespace MMAP
 
         return true;
     }
-
-    bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
-    {
-        // check if we have this map loaded
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
-        {
-            // file may not exist, therefore not loaded
-            sLog->outDebug("MMAP:unloadMapInstance: Asked to unload not loaded navmesh map %03u", mapId);
-            return false;
-        }
-
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-        {
-            sLog->outDebug("MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
-            return false;
-        }
-
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        sLog->outDetail("MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
-
-        return true;
-    }
-
-    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
-    {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
-            return NULL;
-
-        return loadedMMaps[mapId]->navMesh;
-    }
-
-    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
-    {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
-            return NULL;
-
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-        {
-            // allocate mesh query
-            dtNavMeshQuery* query = dtAllocNavMeshQuery();
-            ASSERT(query);
-            if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-            {
-                dtFreeNavMeshQuery(query);
-                sLog->outError("MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-                return NULL;
-            }
-
-            sLog->outDetail("MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
-        }
-
-        return mmap->navMeshQueries[instanceId];
-    }
 }
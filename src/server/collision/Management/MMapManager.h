@@ -21,6 +21,9 @@
 
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include <ace/RW_Thread_Mutex.h>
+#include <ace/Thread_Mutex.h>
 #include "CompilerDefs.h"
 #include "Define.h"
 #include "DetourAlloc.h"
@@ -31,16 +34,31 @@
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::vector<dtNavMeshQuery*> NavMeshQueryPool;
+
+    // poly corridors of recent path searches are kept per map, looked up by start and end polygon
+    #define MMAP_PATH_CACHE_SIZE        512     // entries per map, a power of two
+    #define MMAP_QUERY_MAX_NODES        1024    // search nodes of every dtNavMeshQuery
+
+    struct MMapPathCacheEntry
+    {
+        MMapPathCacheEntry() : startPoly(0), endPoly(0), includeFlags(0), excludeFlags(0) {}
+
+        dtPolyRef startPoly;
+        dtPolyRef endPoly;
+        uint16 includeFlags;                // filter the corridor was searched with
+        uint16 excludeFlags;
+        std::vector<dtPolyRef> path;
+    };
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) {}
+        MMapData(dtNavMesh* mesh) : navMesh(mesh), queryCount(0), pathCache(MMAP_PATH_CACHE_SIZE) {}
         ~MMapData()
         {
-            for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
-                dtFreeNavMeshQuery(i->second);
+            for (NavMeshQueryPool::iterator i = freeQueries.begin(); i != freeQueries.end(); ++i)
+                dtFreeNavMeshQuery(*i);
 
             if (navMesh)
                 dtFreeNavMesh(navMesh);
@@ -48,18 +66,53 @@ namespace MMAP
 
         dtNavMesh* navMesh;
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
+        // dtNavMeshQuery is not thread safe, every thread searching this map takes one of its own from the pool
+        // instances share the pool, they use the same mesh
+        ACE_Thread_Mutex lock;              // guards everything below
+        NavMeshQueryPool freeQueries;       // queries not in use
+        uint32 queryCount;                  // queries created, in use or not
+        std::vector<MMapPathCacheEntry> pathCache;
+
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
     };
 
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
 
+    class MMapManager;
+
+    // Exclusive use of a pooled dtNavMeshQuery of one map, for a single path calculation.
+    // As long as any is held no tile of any map is loaded or unloaded, the mesh and the query stay valid.
+    class NavMeshQueryLease
+    {
+        public:
+            // manager may be NULL, for maps without pathfinding
+            NavMeshQueryLease(MMapManager* manager, uint32 mapId);
+            ~NavMeshQueryLease();
+
+            // NULL if the map has no mmap loaded
+            dtNavMesh const* GetNavMesh() const { return m_data ? m_data->navMesh : NULL; }
+            dtNavMeshQuery const* GetNavMeshQuery() const { return m_query; }
+
+            // corridor found earlier between the same polygons with the same filter
+            bool GetCachedPath(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef* path, uint32& length, uint32 maxLength) const;
+            void StoreCachedPath(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef const* path, uint32 length);
+
+        private:
+            NavMeshQueryLease(NavMeshQueryLease const&);
+            NavMeshQueryLease& operator=(NavMeshQueryLease const&);
+
+            MMapManager* m_manager;
+            MMapData* m_data;
+            dtNavMeshQuery* m_query;
+    };
+
     // singleton class
     // holds all all access to mmap loading unloading and meshes
     class MMapManager
     {
+        friend class NavMeshQueryLease;
+
         public:
             MMapManager() : loadedTiles(0) {}
             ~MMapManager();
@@ -67,20 +120,19 @@ namespace MMAP
             bool loadMap(const std::string& basePath, uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId);
-            bool unloadMapInstance(uint32 mapId, uint32 instanceId);
-
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
-            dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
-            dtNavMesh const* GetNavMesh(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
         private:
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y);
+            void ClearPathCache(MMapData* mmap);
 
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+
+            // read locked by every NavMeshQueryLease, write locked to load or unload maps and tiles
+            ACE_RW_Thread_Mutex m_lock;
     };
 }
 
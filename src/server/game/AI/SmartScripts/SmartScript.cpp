@@ -46,7 +46,6 @@ SmartScript::SmartScript()
     mEventPhase = 0;
     mInvinceabilityHpLevel = 0;
     mPathId = 0;
-    mTargetStorage = new ObjectListMap();
     mStoredEvents.clear();
     mTextTimer = 0;
     mLastTextID = 0;
@@ -62,10 +61,25 @@ SmartScript::SmartScript()
 
 SmartScript::~SmartScript()
 {
-    for (ObjectListMap::iterator itr = mTargetStorage->begin(); itr != mTargetStorage->end(); ++itr)
-        delete itr->second;
+    for (std::vector<ObjectList*>::const_iterator itr = mFreeTargetLists.begin(); itr != mFreeTargetLists.end(); ++itr)
+        delete *itr;
+}
+
+SmartTargetList::SmartTargetList(SmartScript* script) : m_script(script)
+{
+    if (m_script->mFreeTargetLists.empty())
+        m_list = new ObjectList();
+    else
+    {
+        m_list = m_script->mFreeTargetLists.back();
+        m_script->mFreeTargetLists.pop_back();
+    }
+}
 
-    delete mTargetStorage;
+SmartTargetList::~SmartTargetList()
+{
+    m_list->clear();
+    m_script->mFreeTargetLists.push_back(m_list);
 }
 
 void SmartScript::OnReset()
@@ -140,9 +154,10 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
     {
         case SMART_ACTION_TALK:
         {
-            ObjectList* targets = GetTargets(e, unit);
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
             talker = me;
-            if (targets)
+            if (!targets->empty())
             {
                 for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 {
@@ -152,8 +167,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         break;
                     }
                 }
-
-                delete targets;
             }
 
             mLastTextID = e.action.talk.textGroupID;
@@ -167,8 +180,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         }
         case SMART_ACTION_SIMPLE_TALK:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (!targets->empty())
             {
                 for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 {
@@ -182,15 +196,14 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     sLog->outDebug("SmartScript::ProcessAction:: SMART_ACTION_SIMPLE_TALK: talker: %s (GuidLow: %u), textGroupId: %u",
                         (*itr)->GetName(), (*itr)->GetGUIDLow(), uint8(e.action.talk.textGroupID));
                 }
-
-                delete targets;
             }
             break;
         }
         case SMART_ACTION_PLAY_EMOTE:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (!targets->empty())
             {
                 for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 {
@@ -201,15 +214,14 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             (*itr)->GetName(), (*itr)->GetGUIDLow(), e.action.emote.emote);
                     }
                 }
-
-                delete targets;
             }
             break;
         }
         case SMART_ACTION_SOUND:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (!targets->empty())
             {
                 for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 {
@@ -220,15 +232,14 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             (*itr)->GetName(), (*itr)->GetGUIDLow(), e.action.sound.sound, e.action.sound.range);
                     }
                 }
-
-                delete targets;
             }
             break;
         }
         case SMART_ACTION_SET_FACTION:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (!targets->empty())
             {
                 for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 {
@@ -254,15 +265,14 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         }
                     }
                 }
-
-                delete targets;
             }
             break;
         }
         case SMART_ACTION_MORPH_TO_ENTRY_OR_MODEL:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
             {
@@ -297,14 +307,13 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetEntry(), (*itr)->GetGUIDLow());
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_FAIL_QUEST:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
             {
@@ -315,14 +324,13 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), e.action.quest.quest);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_ADD_QUEST:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
             {
@@ -334,8 +342,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             (*itr)->GetGUIDLow(), e.action.quest.quest);
                     }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_SET_REACT_STATE:
@@ -350,8 +356,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         }
         case SMART_ACTION_RANDOM_EMOTE:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             uint32 emotes[SMART_ACTION_PARAM_COUNT];
             emotes[0] = e.action.randomEmote.emote1;
@@ -381,8 +388,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), emote);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_THREAT_ALL_PCT:
@@ -407,8 +412,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (!me)
                 return;
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -420,14 +426,13 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         me->GetGUIDLow(), (*itr)->GetGUIDLow(), e.action.threatPCT.threatINC ? (int32)e.action.threatPCT.threatINC : -(int32)e.action.threatPCT.threatDEC);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_CALL_AREAEXPLOREDOREVENTHAPPENS:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -439,8 +444,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), e.action.quest.quest);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_SEND_CASTCREATUREORGO:
@@ -448,8 +451,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (!GetBaseObject())
                 return;
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -457,8 +461,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsPlayer((*itr)))
                     (*itr)->ToPlayer()->CastedCreatureOrGO(e.action.castedCreatureOrGO.creature, GetBaseObject()->GetGUID(), e.action.castedCreatureOrGO.spell);
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_CAST:
@@ -466,8 +468,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (!me)
                 return;
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -482,8 +485,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         me->GetGUIDLow(), e.action.cast.spell, (*itr)->GetGUIDLow(), e.action.cast.flags);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_INVOKER_CAST:
@@ -492,8 +493,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (!tempLastInvoker)
                 return;
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -506,14 +508,13 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     tempLastInvoker->CastSpell((*itr)->ToUnit(), e.action.cast.spell, (e.action.cast.flags & SMARTCAST_TRIGGERED) ? true : false);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_ADD_AURA:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -525,14 +526,13 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         e.action.cast.spell, (*itr)->GetGUIDLow());
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_ACTIVATE_GOBJECT:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -546,14 +546,13 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), (*itr)->GetEntry());
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_RESET_GOBJECT:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
             {
@@ -564,14 +563,13 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), (*itr)->GetEntry());
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_SET_EMOTE_STATE:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -583,14 +581,13 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), e.action.emote.emote);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_SET_UNIT_FLAG:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
             {
@@ -601,14 +598,13 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), e.action.unitFlag.flag);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_REMOVE_UNIT_FLAG:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -620,8 +616,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), e.action.unitFlag.flag);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_AUTO_ATTACK:
@@ -693,8 +687,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (!GetBaseObject())
                 return;
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -706,14 +701,13 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), e.action.castedCreatureOrGO.creature, e.action.castedCreatureOrGO.spell);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_REMOVEAURASFROMSPELL:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -725,8 +719,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 sLog->outDebug("SmartScript::ProcessAction: SMART_ACTION_REMOVEAURASFROMSPELL: Unit %u, spell %u",
                     (*itr)->GetGUIDLow(), e.action.removeAura.spell);
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_FOLLOW:
@@ -734,8 +726,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (!IsSmart())
                 return;
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -748,8 +741,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     return;
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_RANDOM_PHASE:
@@ -797,8 +788,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
             else if (GetBaseObject())
             {
-                ObjectList* targets = GetTargets(e, unit);
-                if (!targets)
+                SmartTargetList targets(this);
+                GetTargets(*targets, e, unit);
+                if (targets->empty())
                     return;
 
                 for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -810,8 +802,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     sLog->outDebug("SmartScript::ProcessAction: SMART_ACTION_CALL_KILLEDMONSTER: Player %u, Killcredit: %u",
                         (*itr)->GetGUIDLow(), e.action.killedMonster.creature);
                 }
-
-                delete targets;
             }
             else if (trigger && IsPlayer(unit))
             {
@@ -858,15 +848,14 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 return;
             }
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             pInst->SetData64(e.action.setInstanceData64.field, targets->front()->GetGUID());
             sLog->outDebug("SmartScript::ProcessAction: SMART_ACTION_SET_INST_DATA64: Field: %u, data: " UI64FMTD,
                 e.action.setInstanceData64.field, targets->front()->GetGUID());
-
-            delete targets;
             break;
         }
         case SMART_ACTION_UPDATE_TEMPLATE:
@@ -930,8 +919,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         }
         case SMART_ACTION_MOUNT_TO_ENTRY_OR_MODEL:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
             {
@@ -952,8 +942,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 else
                     (*itr)->ToUnit()->Unmount();
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_SET_INVINCIBILITY_HP_LEVEL:
@@ -968,8 +956,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         }
         case SMART_ACTION_SET_DATA:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -979,8 +968,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 else if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->AI()->SetData(e.action.setData.field, e.action.setData.data);
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_MOVE_FORWARD:
@@ -1009,8 +996,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (!me)
                 return;
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -1018,7 +1006,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                 {
                     me->AI()->AttackStart((*itr)->ToUnit());
-                    delete targets;
                     return;
                 }
             }
@@ -1030,8 +1017,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (!obj)
                 obj = unit;
             float x, y, z, o;
-            ObjectList* targets = GetTargets(e, unit);
-            if (targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (!targets->empty())
             {
                 for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 {
@@ -1043,8 +1031,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         if (unit && e.action.summonCreature.attackInvoker)
                             summon->AI()->AttackStart((*itr)->ToUnit());
                 }
-
-                delete targets;
             }
 
             if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1061,8 +1047,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 return;
 
             float x, y, z, o;
-            ObjectList* targets = GetTargets(e, unit);
-            if (targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (!targets->empty())
             {
                 for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 {
@@ -1072,8 +1059,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->GetPosition(x, y, z, o);
                     GetBaseObject()->SummonGameObject(e.action.summonGO.entry, x, y, z, o, 0, 0, 0, 0, e.action.summonGO.despawnTime);
                 }
-
-                delete targets;
             }
 
             if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1084,8 +1069,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         }
         case SMART_ACTION_KILL_UNIT:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
             {
@@ -1094,8 +1080,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
                 (*itr)->ToUnit()->Kill((*itr)->ToUnit());
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_INSTALL_AI_TEMPLATE:
@@ -1105,8 +1089,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         }
         case SMART_ACTION_ADD_ITEM:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -1116,14 +1101,13 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
                 (*itr)->ToPlayer()->AddItem(e.action.item.entry, e.action.item.count);
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_REMOVE_ITEM:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -1133,8 +1117,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
                 (*itr)->ToPlayer()->DestroyItemCount(e.action.item.entry, e.action.item.count, true);
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_STORE_VARIABLE_DECIMAL:
@@ -1146,14 +1128,16 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         }
         case SMART_ACTION_STORE_TARGET_LIST:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            StoreTargetList(targets, e.action.storeTargets.id);
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            StoreTargetList(*targets, e.action.storeTargets.id);
             break;
         }
         case SMART_ACTION_TELEPORT:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -1163,8 +1147,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
                 (*itr)->ToPlayer()->TeleportTo(e.action.teleport.mapID, e.target.x, e.target.y, e.target.z, e.target.o);
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_SET_FLY:
@@ -1195,8 +1177,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             bool run = e.action.wpStart.run ? true : false;
             uint32 entry = e.action.wpStart.pathID;
             bool repeat = e.action.wpStart.repeat ? true : false;
-            ObjectList* targets = GetTargets(e, unit);
-            StoreTargetList(targets, SMART_ESCORT_TARGETS);
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            StoreTargetList(*targets, SMART_ESCORT_TARGETS);
             me->SetReactState((ReactStates)e.action.wpStart.reactState);
             CAST_AI(SmartAI, me->AI())->StartPath(run, entry, repeat, unit);
 
@@ -1236,21 +1219,21 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (!me)
                 return;
 
-            ObjectList* targets = GetTargets(e, unit);
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
             if (e.GetTargetType() == SMART_TARGET_SELF)
                 me->SetFacingTo((me->GetTransport() ? me->GetTransportHomePosition() : me->GetHomePosition()).GetOrientation());
             else if (e.GetTargetType() == SMART_TARGET_POSITION)
                 me->SetFacingTo(e.target.o);
-            else if (targets && !targets->empty())
+            else if (!targets->empty())
                 me->SetFacingTo(0);
-
-            delete targets;
             break;
         }
         case SMART_ACTION_PLAYMOVIE:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -1260,8 +1243,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
                 (*itr)->ToPlayer()->SendMovieStart(e.action.movie.entry);
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_MOVE_TO_POS:
@@ -1275,8 +1256,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         }
         case SMART_ACTION_RESPAWN_TARGET:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -1286,27 +1268,25 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 else if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->Respawn();
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_CLOSE_GOSSIP:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 if (IsPlayer(*itr))
                     (*itr)->ToPlayer()->PlayerTalkClass->CloseGossip();
-
-            delete targets;
             break;
         }
         case SMART_ACTION_EQUIP:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -1341,8 +1321,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         npc->SetUInt32Value(UNIT_VIRTUAL_ITEM_SLOT_ID + 2, slot[2]);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_CREATE_TIMED_EVENT:
@@ -1384,8 +1362,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             break;
         case SMART_ACTION_OVERRIDE_SCRIPT_BASE_OBJECT:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -1398,8 +1377,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         goOrigGUID = go ? go->GetGUID() : 0;
                     go = NULL;
                     me = (*itr)->ToCreature();
-
-                    delete targets;
                     return;
                 }
                 else if (IsGameObject(*itr))
@@ -1410,13 +1387,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         goOrigGUID = go ? go->GetGUID() : 0;
                     go = (*itr)->ToGameObject();
                     me = NULL;
-
-                    delete targets;
                     return;
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_RESET_SCRIPT_BASE_OBJECT:
@@ -1430,8 +1403,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (!me)
                 return;
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             if (e.action.enterVehicle.seat <= MAX_VEHICLE_SEATS)
@@ -1441,7 +1415,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr) && (*itr)->ToUnit()->GetVehicleKit())
                     {
                         me->EnterVehicle((*itr)->ToUnit(), e.action.enterVehicle.seat);
-                        delete targets;
                         return;
                     }
                 }
@@ -1458,8 +1431,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_CALL_TIMED_ACTIONLIST:
@@ -1470,8 +1441,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 return;
             }
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (!targets->empty())
             {
                 for (ObjectList::iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 {
@@ -1486,62 +1458,56 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             CAST_AI(SmartGameObjectAI, target->AI())->SetScript9(e, e.action.timedActionList.id, GetLastInvoker());
                     }
                 }
-
-                delete targets;
             }
             break;
         }
         case SMART_ACTION_SET_NPC_FLAG:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetUInt32Value(UNIT_NPC_FLAGS, e.action.unitFlag.flag);
-
-            delete targets;
             break;
         }
         case SMART_ACTION_ADD_NPC_FLAG:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetFlag(UNIT_NPC_FLAGS, e.action.unitFlag.flag);
-
-            delete targets;
             break;
         }
         case SMART_ACTION_REMOVE_NPC_FLAG:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveFlag(UNIT_NPC_FLAGS, e.action.unitFlag.flag);
-
-            delete targets;
             break;
         }
         case SMART_ACTION_CROSS_CAST:
         {
-            ObjectList* casters = GetTargets(CreateEvent(SMART_EVENT_UPDATE_IC, 0, 0, 0, 0, 0, SMART_ACTION_NONE, 0, 0, 0, 0, 0, 0, (SMARTAI_TARGETS)e.action.cast.targetType, e.action.cast.targetParam1, e.action.cast.targetParam2, e.action.cast.targetParam3, 0), unit);
-            if (!casters)
+            SmartTargetList casters(this);
+            GetTargets(*casters, CreateEvent(SMART_EVENT_UPDATE_IC, 0, 0, 0, 0, 0, SMART_ACTION_NONE, 0, 0, 0, 0, 0, 0, (SMARTAI_TARGETS)e.action.cast.targetType, e.action.cast.targetParam1, e.action.cast.targetParam2, e.action.cast.targetParam3, 0), unit);
+            if (casters->empty())
                 return;
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
-            {
-                delete casters; // casters already validated, delete now
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
-            }
 
             for (ObjectList::const_iterator itr = casters->begin(); itr != casters->end(); ++itr)
             {
@@ -1555,9 +1521,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             (*itr)->ToUnit()->CastSpell((*it)->ToUnit(), e.action.cast.spell, (e.action.cast.flags & SMARTCAST_TRIGGERED) ? true : false);
                 }
             }
-
-            delete targets;
-            delete casters;
             break;
         }
         case SMART_ACTION_CALL_RANDOM_TIMED_ACTIONLIST:
@@ -1587,8 +1550,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 return;
             }
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (!targets->empty())
             {
                 for (ObjectList::iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 {
@@ -1603,8 +1567,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             CAST_AI(SmartGameObjectAI, target->AI())->SetScript9(e, id, GetLastInvoker());
                     }
                 }
-
-                delete targets;
             }
             break;
         }
@@ -1617,8 +1579,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 return;
             }
 
-            ObjectList* targets = GetTargets(e, unit);
-            if (targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (!targets->empty())
             {
                 for (ObjectList::iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 {
@@ -1632,28 +1595,26 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             CAST_AI(SmartGameObjectAI, target->AI())->SetScript9(e, id, GetLastInvoker());
                     }
                 }
-
-                delete targets;
             }
             break;
         }
         case SMART_ACTION_ACTIVATE_TAXI:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 if (IsPlayer(*itr))
                     (*itr)->ToPlayer()->ActivateTaxiPathTo(e.action.taxi.id);
-
-            delete targets;
             break;
         }
         case SMART_ACTION_RANDOM_MOVE:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
@@ -1666,64 +1627,59 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->ToCreature()->GetMotionMaster()->MoveIdle();
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_SET_UNIT_FIELD_BYTES_1:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetByteFlag(UNIT_FIELD_BYTES_1, 0, e.action.setunitByte.byte1);
-
-            delete targets;
             break;
         }
         case SMART_ACTION_REMOVE_UNIT_FIELD_BYTES_1:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveByteFlag(UNIT_FIELD_BYTES_1, 0, e.action.delunitByte.byte1);
-
-            delete targets;
             break;
         }
         case SMART_ACTION_INTERRUPT_SPELL:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->InterruptNonMeleeSpells(e.action.interruptSpellCasting.withDelayed, e.action.interruptSpellCasting.spell_id, e.action.interruptSpellCasting.withInstant);
-
-            delete targets;
             break;
         }
         case SMART_ACTION_SEND_GO_CUSTOM_ANIM:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
 
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SendCustomAnim(e.action.sendGoCustomAnim.anim);
-
-            delete targets;
             break;
         }
         case SMART_ACTION_COMPLETE_ACHIEVEMENT:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             AchievementEntry const* achiev = sAchievementStore.LookupEntry(e.action.achievement.achievementId);
             if (!achiev) // should not happen
@@ -1735,15 +1691,14 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToPlayer()->CompletedAchievement(achiev);
                 }
             }
-
-            delete targets;
             break;
         }
         case SMART_ACTION_LEARN_SPELL:
         case SMART_ACTION_UNLEARN_SPELL:
         {
-            ObjectList* targets = GetTargets(e, unit);
-            if (!targets)
+            SmartTargetList targets(this);
+            GetTargets(*targets, e, unit);
+            if (targets->empty())
                 return;
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
             {
@@ -1755,8 +1710,6 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->ToPlayer()->RemoveSpell(e.action.spell.spellID, false, false);
                 }
             }
-
-            delete targets;
             break;
         }
         default:
@@ -1765,7 +1718,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
     }
 }
 
-void SmartScript::InstallTemplate(SmartScriptHolder e)
+void SmartScript::InstallTemplate(SmartScriptHolder const& e)
 {
     if (!GetBaseObject())
         return;
@@ -1871,7 +1824,7 @@ SmartScriptHolder SmartScript::CreateEvent(SMART_EVENT e, uint32 event_flags, ui
     return script;
 }
 
-ObjectList* SmartScript::GetTargets(SmartScriptHolder e, Unit* invoker)
+void SmartScript::GetTargets(ObjectList& targets, SmartScriptHolder const& e, Unit* invoker)
 {
     Unit* trigger = NULL;
     if (invoker)
@@ -1879,61 +1832,60 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder e, Unit* invoker)
     else if (Unit* tempLastInvoker = GetLastInvoker())
         trigger = tempLastInvoker;
 
-    ObjectList* l = new ObjectList();
     switch (e.GetTargetType())
     {
         case SMART_TARGET_SELF:
             if (GetBaseObject())
-                l->push_back(GetBaseObject());
+                targets.push_back(GetBaseObject());
             break;
         case SMART_TARGET_VICTIM:
             if (me && me->GetVictim())
-                l->push_back(me->GetVictim());
+                targets.push_back(me->GetVictim());
             break;
         case SMART_TARGET_HOSTILE_SECOND_AGGRO:
             if (me)
                 if (Unit* u = me->AI()->SelectTarget(SELECT_TARGET_TOPAGGRO, 1))
-                    l->push_back(u);
+                    targets.push_back(u);
             break;
         case SMART_TARGET_HOSTILE_LAST_AGGRO:
             if (me)
                 if (Unit* u = me->AI()->SelectTarget(SELECT_TARGET_BOTTOMAGGRO, 0))
-                    l->push_back(u);
+                    targets.push_back(u);
             break;
         case SMART_TARGET_HOSTILE_RANDOM:
             if (me)
                 if (Unit* u = me->AI()->SelectTarget(SELECT_TARGET_RANDOM, 0))
-                    l->push_back(u);
+                    targets.push_back(u);
             break;
         case SMART_TARGET_HOSTILE_RANDOM_NOT_TOP:
             if (me)
                 if (Unit* u = me->AI()->SelectTarget(SELECT_TARGET_RANDOM, 1))
-                    l->push_back(u);
+                    targets.push_back(u);
             break;
         case SMART_TARGET_NONE:
         case SMART_TARGET_ACTION_INVOKER:
             if (trigger)
-                l->push_back(trigger);
+                targets.push_back(trigger);
             break;
         case SMART_TARGET_ACTION_INVOKER_VEHICLE:
             if (trigger && trigger->GetVehicle() && trigger->GetVehicle()->GetBase())
-                l->push_back(trigger->GetVehicle()->GetBase());
+                targets.push_back(trigger->GetVehicle()->GetBase());
             break;
         case SMART_TARGET_INVOKER_PARTY:
             if (trigger)
             {
-                l->push_back(trigger);
+                targets.push_back(trigger);
                 if (Player* plr = trigger->ToPlayer())
                     if (Group* pGroup = plr->GetGroup())
                         for (GroupReference* groupRef = pGroup->GetFirstMember(); groupRef != NULL; groupRef = groupRef->next())
                             if (Player* member = groupRef->getSource())
-                                l->push_back(member);
+                                targets.push_back(member);
             }
             break;
         case SMART_TARGET_CREATURE_RANGE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.unitRange.maxDist);
+            SmartTargetList units(this);
+            GetWorldObjectsInDist(*units, (float)e.target.unitRange.maxDist);
             for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
             {
                 if (!IsCreature(*itr))
@@ -1943,16 +1895,14 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder e, Unit* invoker)
                     continue;
 
                 if (((e.target.unitRange.creature && (*itr)->ToCreature()->GetEntry() == e.target.unitRange.creature) || !e.target.unitRange.creature) && GetBaseObject()->IsInRange(*itr, (float)e.target.unitRange.minDist, (float)e.target.unitRange.maxDist))
-                    l->push_back(*itr);
+                    targets.push_back(*itr);
             }
-
-            delete units;
             break;
         }
         case SMART_TARGET_CREATURE_DISTANCE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.unitDistance.dist);
+            SmartTargetList units(this);
+            GetWorldObjectsInDist(*units, (float)e.target.unitDistance.dist);
             for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
             {
                 if (!IsCreature(*itr))
@@ -1962,16 +1912,14 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder e, Unit* invoker)
                     continue;
 
                 if ((e.target.unitDistance.creature && (*itr)->ToCreature()->GetEntry() == e.target.unitDistance.creature) || !e.target.unitDistance.creature)
-                    l->push_back(*itr);
+                    targets.push_back(*itr);
             }
-
-            delete units;
             break;
         }
         case SMART_TARGET_GAMEOBJECT_DISTANCE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.goDistance.dist);
+            SmartTargetList units(this);
+            GetWorldObjectsInDist(*units, (float)e.target.goDistance.dist);
             for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
             {
                 if (!IsGameObject(*itr))
@@ -1981,16 +1929,14 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder e, Unit* invoker)
                     continue;
 
                 if ((e.target.goDistance.entry && (*itr)->ToGameObject()->GetEntry() == e.target.goDistance.entry) || !e.target.goDistance.entry)
-                    l->push_back(*itr);
+                    targets.push_back(*itr);
             }
-
-            delete units;
             break;
         }
         case SMART_TARGET_GAMEOBJECT_RANGE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.goRange.maxDist);
+            SmartTargetList units(this);
+            GetWorldObjectsInDist(*units, (float)e.target.goRange.maxDist);
             for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
             {
                 if(!IsGameObject(*itr))
@@ -2000,10 +1946,8 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder e, Unit* invoker)
                     continue;
 
                 if (((e.target.goRange.entry && IsGameObject(*itr) && (*itr)->ToGameObject()->GetEntry() == e.target.goRange.entry) || !e.target.goRange.entry) && GetBaseObject()->IsInRange((*itr), (float)e.target.goRange.minDist, (float)e.target.goRange.maxDist))
-                    l->push_back(*itr);
+                    targets.push_back(*itr);
             }
-
-            delete units;
             break;
         }
         case SMART_TARGET_CREATURE_GUID:
@@ -2026,7 +1970,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder e, Unit* invoker)
             }
 
             if (target)
-                l->push_back(target);
+                targets.push_back(target);
             break;
         }
         case SMART_TARGET_GAMEOBJECT_GUID:
@@ -2049,59 +1993,54 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder e, Unit* invoker)
             }
 
             if (target)
-                l->push_back(target);
+                targets.push_back(target);
             break;
         }
         case SMART_TARGET_PLAYER_RANGE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.playerRange.maxDist);
+            SmartTargetList units(this);
+            GetWorldObjectsInDist(*units, (float)e.target.playerRange.maxDist);
             if (!units->empty() && GetBaseObject())
                 for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
                     if (IsPlayer(*itr) && GetBaseObject()->IsInRange(*itr, (float)e.target.playerRange.minDist, (float)e.target.playerRange.maxDist))
-                        l->push_back(*itr);
-
-            delete units;
+                        targets.push_back(*itr);
             break;
         }
         case SMART_TARGET_PLAYER_DISTANCE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.playerDistance.dist);
+            SmartTargetList units(this);
+            GetWorldObjectsInDist(*units, (float)e.target.playerDistance.dist);
             for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
                 if (IsPlayer(*itr))
-                    l->push_back(*itr);
-
-            delete units;
+                    targets.push_back(*itr);
             break;
         }
         case SMART_TARGET_STORED:
         {
-            ObjectListMap::iterator itr = mTargetStorage->find(e.target.stored.id);
-            if (itr != mTargetStorage->end())
-                l->assign(itr->second->begin(), itr->second->end());
-
-            return l;
+            ObjectListMap::const_iterator itr = mTargetStorage.find(e.target.stored.id);
+            if (itr != mTargetStorage.end())
+                targets.assign(itr->second.begin(), itr->second.end());
+            break;
         }
         case SMART_TARGET_CLOSEST_CREATURE:
         {
             Creature* target = GetClosestCreatureWithEntry(GetBaseObject(), e.target.closest.entry, (float)(e.target.closest.dist ? e.target.closest.dist : 100), e.target.closest.dead ? false : true);
             if (target)
-                l->push_back(target);
+                targets.push_back(target);
             break;
         }
         case SMART_TARGET_CLOSEST_GAMEOBJECT:
         {
             GameObject* target = GetClosestGameObjectWithEntry(GetBaseObject(), e.target.closest.entry, (float)(e.target.closest.dist ? e.target.closest.dist : 100));
             if (target)
-                l->push_back(target);
+                targets.push_back(target);
             break;
         }
         case SMART_TARGET_OWNER_OR_SUMMONER:
         {
             if (me)
                 if (Unit* owner = ObjectAccessor::GetUnit(*me, me->GetCharmerOrOwnerGUID()))
-                    l->push_back(owner);
+                    targets.push_back(owner);
             break;
         }
         case SMART_TARGET_THREAT_LIST:
@@ -2111,7 +2050,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder e, Unit* invoker)
                 std::list<HostileReference*> const& threatList = me->getThreatManager().getThreatList();
                 for (std::list<HostileReference*>::const_iterator i = threatList.begin(); i != threatList.end(); ++i)
                     if (Unit* temp = Unit::GetUnit(*me, (*i)->getUnitGuid()))
-                        l->push_back(temp);
+                        targets.push_back(temp);
             }
             break;
         }
@@ -2119,27 +2058,17 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder e, Unit* invoker)
         default:
             break;
     }
-
-    if (l->empty())
-    {
-        delete l;
-        l = NULL;
-    }
-
-    return l;
 }
 
-ObjectList* SmartScript::GetWorldObjectsInDist(float dist)
+void SmartScript::GetWorldObjectsInDist(ObjectList& targets, float dist)
 {
-    ObjectList* targets = new ObjectList();
     WorldObject* obj = GetBaseObject();
     if (obj)
     {
         Trinity::AllWorldObjectsInRange u_check(obj, dist);
-        Trinity::WorldObjectListSearcher<Trinity::AllWorldObjectsInRange> searcher(obj, *targets, u_check);
+        Trinity::WorldObjectListSearcher<Trinity::AllWorldObjectsInRange, ObjectList> searcher(obj, targets, u_check);
         obj->VisitNearbyObject(dist, searcher);
     }
-    return targets;
 }
 
 void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellEntry* spell, GameObject* gob)
@@ -2691,7 +2620,7 @@ void SmartScript::OnUpdate(uint32 const diff)
     }
 }
 
-void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at)
+void SmartScript::FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTriggerEntry const* at)
 {
     if (e.empty())
     {
@@ -2701,7 +2630,7 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
             sLog->outDebug("SmartScript: EventMap for AreaTrigger %u is empty but is using SmartScript.", at->id);
         return;
     }
-    for (SmartAIEventList::iterator i = e.begin(); i != e.end(); ++i)
+    for (SmartAIEventList::const_iterator i = e.begin(); i != e.end(); ++i)
     {
         #ifndef TRINITY_DEBUG
             if ((*i).event.event_flags & SMART_EVENT_FLAG_DEBUG_ONLY)
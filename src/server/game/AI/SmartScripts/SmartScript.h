@@ -34,15 +34,39 @@
 #include "SmartScriptMgr.h"
 //#include "SmartAI.h"
 
+class SmartScript;
+
+// Target list borrowed from the pool of a SmartScript until it goes out of scope.
+// Released lists keep their capacity, so selecting targets stops allocating once the script has run a while.
+// Actions may trigger other events of the same script, so every selection borrows its own list.
+class SmartTargetList
+{
+    public:
+        explicit SmartTargetList(SmartScript* script);
+        ~SmartTargetList();
+
+        ObjectList* operator->() const { return m_list; }
+        ObjectList& operator*() const { return *m_list; }
+
+    private:
+        SmartTargetList(SmartTargetList const&);
+        SmartTargetList& operator=(SmartTargetList const&);
+
+        SmartScript* m_script;
+        ObjectList* m_list;
+};
+
 class SmartScript
 {
+    friend class SmartTargetList;
+
     public:
         SmartScript();
         ~SmartScript();
 
         void OnInitialize(WorldObject* obj, AreaTriggerEntry const* at = NULL);
         void GetScript();
-        void FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at);
+        void FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTriggerEntry const* at);
 
         void ProcessEventsFor(SMART_EVENT e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellEntry* spell = NULL, GameObject* gob = NULL);
         void ProcessEvent(SmartScriptHolder& e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellEntry* spell = NULL, GameObject* gob = NULL);
@@ -51,9 +75,9 @@ class SmartScript
         void UpdateTimer(SmartScriptHolder& e, uint32 const diff);
         void InitTimer(SmartScriptHolder& e);
         void ProcessAction(SmartScriptHolder& e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellEntry* spell = NULL, GameObject* gob = NULL);
-        ObjectList* GetTargets(SmartScriptHolder e, Unit* invoker = NULL);
-        ObjectList* GetWorldObjectsInDist(float dist);
-        void InstallTemplate(SmartScriptHolder e);
+        void GetTargets(ObjectList& targets, SmartScriptHolder const& e, Unit* invoker = NULL);
+        void GetWorldObjectsInDist(ObjectList& targets, float dist);
+        void InstallTemplate(SmartScriptHolder const& e);
         SmartScriptHolder CreateEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 phaseMask = 0);
         void AddEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 phaseMask = 0);
         void SetPathId(uint32 id) { mPathId = id; }
@@ -107,15 +131,12 @@ class SmartScript
         void DoFindFriendlyCC(std::list<Creature*>& _list, float range);
         void DoFindFriendlyMissingBuff(std::list<Creature*>& _list, float range, uint32 spellid);
 
-        void StoreTargetList(ObjectList* targets, uint32 id)
+        void StoreTargetList(ObjectList const& targets, uint32 id)
         {
-            if (!targets)
+            if (targets.empty())
                 return;
 
-            if (mTargetStorage->find(id) != mTargetStorage->end())
-                delete (*mTargetStorage)[id];
-
-            (*mTargetStorage)[id] = targets;
+            mTargetStorage[id] = targets;
         }
 
         bool IsSmart(Creature* c = NULL)
@@ -148,9 +169,9 @@ class SmartScript
 
         ObjectList* GetTargetList(uint32 id)
         {
-            ObjectListMap::iterator itr = mTargetStorage->find(id);
-            if(itr != mTargetStorage->end())
-                return (*itr).second;
+            ObjectListMap::iterator itr = mTargetStorage.find(id);
+            if(itr != mTargetStorage.end())
+                return &itr->second;
             return NULL;
         }
 
@@ -187,7 +208,7 @@ class SmartScript
             return crea;
         }
 
-        ObjectListMap* mTargetStorage;
+        ObjectListMap mTargetStorage;
 
         void OnReset();
         void ResetBaseObject()
@@ -257,6 +278,9 @@ class SmartScript
         SMARTAI_TEMPLATE mTemplate;
         void InstallEvents();
 
+        // target lists not borrowed at the moment, see SmartTargetList
+        std::vector<ObjectList*> mFreeTargetLists;
+
         void RemoveStoredEvent (uint32 id)
         {
             if (!mStoredEvents.empty())
@@ -1190,8 +1190,8 @@ struct SmartScriptHolder
 
 typedef std::unordered_map<uint32, WayPoint*> WPPath;
 
-typedef std::list<WorldObject*> ObjectList;
-typedef std::unordered_map<uint32, ObjectList*> ObjectListMap;
+typedef std::vector<WorldObject*> ObjectList;
+typedef std::unordered_map<uint32, ObjectList> ObjectListMap;
 
 class SmartWaypointMgr
 {
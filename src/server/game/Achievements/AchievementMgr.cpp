@@ -772,21 +772,16 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
     if (!sWorld->getBoolConfig(CONFIG_GM_ALLOW_ACHIEVEMENT_GAINS) && m_player->GetSession()->GetSecurity() > SEC_PLAYER)
         return;
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type);
+    // disabled criteria and those of the other faction are already left out
+    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaForUpdate(type, miscvalue1, GetPlayer()->GetTeamId());
     for (AchievementCriteriaEntryList::const_iterator i = achievementCriteriaList.begin(); i != achievementCriteriaList.end(); ++i)
     {
         AchievementCriteriaEntry const *achievementCriteria = (*i);
-        if (sDisableMgr->IsDisabledFor(DISABLE_TYPE_ACHIEVEMENT_CRITERIA, achievementCriteria->ID, NULL))
-            continue;
 
         AchievementEntry const *achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
         if (!achievement)
             continue;
 
-        if ((achievement->factionFlag == ACHIEVEMENT_FACTION_HORDE    && GetPlayer()->GetTeam() != HORDE) ||
-            (achievement->factionFlag == ACHIEVEMENT_FACTION_ALLIANCE && GetPlayer()->GetTeam() != ALLIANCE))
-            continue;
-
         // don't update guild achievement criterias for players
         if (achievement->flags & ACHIEVEMENT_FLAG_GUILD_ACHIEVEMENT)
             continue;
@@ -2498,10 +2493,158 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
             m_AchievementCriteriasByTimedType[criteria->timedType].push_back(criteria);
     }
 
+    BuildAchievementCriteriaUpdateLists();
+
     sLog->outString();
     sLog->outString(">> Loaded %lu achievement criteria.",(unsigned long)m_AchievementCriteriasByType->size());
 }
 
+// Criteria types that only match the asset given in miscvalue1 when it is not 0,
+// UpdateAchievementCriteria of the player (or of the guild) skips all the others.
+static bool IsAssetCriteriaType(AchievementCriteriaTypes type, bool guild)
+{
+    switch (type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_GUILD_CHALLENGE_SPECIFIC:
+            return guild;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+            return !guild;
+        default:
+            return false;
+    }
+}
+
+// the field UpdateAchievementCriteria compares miscvalue1 with
+static uint32 GetCriteriaAsset(AchievementCriteriaEntry const* criteria)
+{
+    switch (criteria->requiredType)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:           return criteria->kill_creature.creatureID;
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:       return criteria->reach_skill_level.skillID;
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:        return criteria->be_spell_target.spellID;
+        case ACHIEVEMENT_CRITERIA_TYPE_GUILD_CHALLENGE_SPECIFIC: return criteria->guild_challenge.type;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:       return criteria->learn_skill_level.skillID;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE: return criteria->complete_quests_in_zone.zoneID;
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:      return criteria->killed_by_creature.creatureEntry;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:          return criteria->complete_quest.questID;
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:             return criteria->cast_spell.spellID;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:             return criteria->learn_spell.spellID;
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:               return criteria->loot_type.lootType;
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:               return criteria->own_item.itemID;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:                return criteria->use_item.itemID;
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:         return criteria->gain_reputation.factionID;
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:                return criteria->do_emote.emoteID;
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:              return criteria->equip_item.itemID;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:          return criteria->use_gameobject.goEntry;
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:      return criteria->fish_in_gameobject.goEntry;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:  return criteria->learn_skillline_spell.skillLine;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:        return criteria->learn_skill_line.skillLine;
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:    return criteria->bg_objective.objectiveId;
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:  return criteria->honorable_kill_at_area.areaID;
+        default:                                                return 0;
+    }
+}
+
+void AchievementGlobalMgr::BuildAchievementCriteriaUpdateLists()
+{
+    // reload case
+    for (uint8 team = 0; team < 2; ++team)
+    {
+        for (uint32 type = 0; type < ACHIEVEMENT_CRITERIA_TYPE_TOTAL; ++type)
+            m_UpdateCriteriasByType[team][type].clear();
+        m_UpdateCriteriasByAsset[team].clear();
+    }
+    for (uint32 type = 0; type < ACHIEVEMENT_CRITERIA_TYPE_TOTAL; ++type)
+        m_GuildUpdateCriteriasByType[type].clear();
+    m_GuildUpdateCriteriasByAsset.clear();
+
+    for (uint32 type = 0; type < ACHIEVEMENT_CRITERIA_TYPE_TOTAL; ++type)
+    {
+        for (AchievementCriteriaEntryList::const_iterator itr = m_AchievementCriteriasByType[type].begin(); itr != m_AchievementCriteriasByType[type].end(); ++itr)
+        {
+            AchievementCriteriaEntry const* criteria = *itr;
+            if (sDisableMgr->IsDisabledFor(DISABLE_TYPE_ACHIEVEMENT_CRITERIA, criteria->ID, NULL))
+                continue;
+
+            AchievementEntry const* achievement = sAchievementStore.LookupEntry(criteria->referredAchievement);
+            for (uint8 team = 0; team < 2; ++team)
+            {
+                if ((achievement->factionFlag == ACHIEVEMENT_FACTION_HORDE    && team != TEAM_HORDE) ||
+                    (achievement->factionFlag == ACHIEVEMENT_FACTION_ALLIANCE && team != TEAM_ALLIANCE))
+                    continue;
+
+                m_UpdateCriteriasByType[team][type].push_back(criteria);
+                if (IsAssetCriteriaType(AchievementCriteriaTypes(type), false))
+                    m_UpdateCriteriasByAsset[team][(uint64(type) << 32) | GetCriteriaAsset(criteria)].push_back(criteria);
+            }
+        }
+
+        for (AchievementCriteriaEntryList::const_iterator itr = m_GuildAchievementCriteriasByType[type].begin(); itr != m_GuildAchievementCriteriasByType[type].end(); ++itr)
+        {
+            AchievementCriteriaEntry const* criteria = *itr;
+            if (sDisableMgr->IsDisabledFor(DISABLE_TYPE_ACHIEVEMENT_CRITERIA, criteria->ID, NULL))
+                continue;
+
+            m_GuildUpdateCriteriasByType[type].push_back(criteria);
+            if (IsAssetCriteriaType(AchievementCriteriaTypes(type), true))
+                m_GuildUpdateCriteriasByAsset[(uint64(type) << 32) | GetCriteriaAsset(criteria)].push_back(criteria);
+        }
+    }
+}
+
+AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteriaForUpdate(AchievementCriteriaTypes type, uint64 miscvalue1, TeamId team) const
+{
+    uint8 teamIndex = team == TEAM_HORDE ? 1 : 0;
+    if (!miscvalue1 || !IsAssetCriteriaType(type, false))
+        return m_UpdateCriteriasByType[teamIndex][type];
+
+    // no criteria of these types has an asset above 32 bits
+    if (miscvalue1 > 0xFFFFFFFF)
+        return m_EmptyCriteriaList;
+
+    AchievementCriteriaListByAsset::const_iterator itr = m_UpdateCriteriasByAsset[teamIndex].find((uint64(type) << 32) | miscvalue1);
+    return itr != m_UpdateCriteriasByAsset[teamIndex].end() ? itr->second : m_EmptyCriteriaList;
+}
+
+AchievementCriteriaEntryList const& AchievementGlobalMgr::GetGuildAchievementCriteriaForUpdate(AchievementCriteriaTypes type, uint64 miscvalue1) const
+{
+    if (!miscvalue1 || !IsAssetCriteriaType(type, true))
+        return m_GuildUpdateCriteriasByType[type];
+
+    if (miscvalue1 > 0xFFFFFFFF)
+        return m_EmptyCriteriaList;
+
+    AchievementCriteriaListByAsset::const_iterator itr = m_GuildUpdateCriteriasByAsset.find((uint64(type) << 32) | miscvalue1);
+    return itr != m_GuildUpdateCriteriasByAsset.end() ? itr->second : m_EmptyCriteriaList;
+}
+
 void AchievementGlobalMgr::LoadAchievementReferenceList()
 {
     if (sAchievementStore.GetNumRows() == 0)
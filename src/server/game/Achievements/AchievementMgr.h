@@ -31,12 +31,14 @@
 #include "DatabaseEnv.h"
 #include "DBCEnums.h"
 #include "DBCStores.h"
+#include "SharedDefines.h"
 
 typedef std::list<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
 typedef std::list<AchievementEntry const*>         AchievementEntryList;
 
 typedef std::map<uint32,AchievementCriteriaEntryList> AchievementCriteriaListByAchievement;
 typedef std::map<uint32,AchievementEntryList>         AchievementListByReferencedId;
+typedef std::unordered_map<uint64,AchievementCriteriaEntryList> AchievementCriteriaListByAsset;    // criteria type << 32 | asset
 
 struct CriteriaProgress
 {
@@ -306,6 +308,11 @@ class AchievementGlobalMgr
         AchievementCriteriaEntryList const& GetGuildAchievementCriteriaByType(AchievementCriteriaTypes type);
         AchievementCriteriaEntryList const& GetTimedAchievementCriteriaByType(AchievementCriteriaTimedTypes type);
 
+        // Criteria an update of this type has to check: not disabled and, for players, of the player's team.
+        // Types which only match the asset (creature, item, spell...) given in miscvalue1 return the criteria of that asset.
+        AchievementCriteriaEntryList const& GetAchievementCriteriaForUpdate(AchievementCriteriaTypes type, uint64 miscvalue1, TeamId team) const;
+        AchievementCriteriaEntryList const& GetGuildAchievementCriteriaForUpdate(AchievementCriteriaTypes type, uint64 miscvalue1) const;
+
         AchievementCriteriaEntryList const* GetAchievementCriteriaByAchievement(uint32 id)
         {
             AchievementCriteriaListByAchievement::const_iterator itr = m_AchievementCriteriaListByAchievement.find(id);
@@ -353,6 +360,7 @@ class AchievementGlobalMgr
         }
 
         void LoadAchievementCriteriaList();
+        void BuildAchievementCriteriaUpdateLists();         // again after the disables are reloaded
         void LoadAchievementCriteriaData();
         void LoadAchievementReferenceList();
         void LoadCompletedAchievements();
@@ -369,6 +377,12 @@ class AchievementGlobalMgr
         AchievementCriteriaListByAchievement m_GuildAchievementCriteriaListByAchievement;
         // store achievement criterias by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
+        // criteria for updates, disabled ones removed, players' by TEAM_ALLIANCE and TEAM_HORDE
+        AchievementCriteriaEntryList m_UpdateCriteriasByType[2][ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        AchievementCriteriaListByAsset m_UpdateCriteriasByAsset[2];
+        AchievementCriteriaEntryList m_GuildUpdateCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        AchievementCriteriaListByAsset m_GuildUpdateCriteriasByAsset;
+        AchievementCriteriaEntryList m_EmptyCriteriaList;
         // store achievements by referenced achievement id to speed up lookup
         AchievementListByReferencedId m_AchievementListByReferencedId;
 
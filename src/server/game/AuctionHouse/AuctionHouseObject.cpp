@@ -4,6 +4,113 @@
 #include "AuctionHouseMgr.h"
 #include "ScriptMgr.h"
 
+// expired auctions settled in one transaction
+#define AUCTION_EXPIRY_BATCH_SIZE 200
+
+typedef std::unordered_map<uint64, std::vector<uint32> > AuctionIndexMap;
+
+static void UpdatePostingList(AuctionIndexMap& index, uint64 key, uint32 auctionId, bool add)
+{
+    if (add)
+    {
+        std::vector<uint32>& list = index[key];
+        // auction ids only grow, a new auction goes to the end
+        if (list.empty() || list.back() < auctionId)
+            list.push_back(auctionId);
+        else
+        {
+            std::vector<uint32>::iterator itr = std::lower_bound(list.begin(), list.end(), auctionId);
+            if (itr == list.end() || *itr != auctionId)
+                list.insert(itr, auctionId);
+        }
+        return;
+    }
+
+    AuctionIndexMap::iterator itr = index.find(key);
+    if (itr == index.end())
+        return;
+
+    std::vector<uint32>& list = itr->second;
+    std::vector<uint32>::iterator pos = std::lower_bound(list.begin(), list.end(), auctionId);
+    if (pos != list.end() && *pos == auctionId)
+        list.erase(pos);
+
+    if (list.empty())
+        index.erase(itr);
+}
+
+static std::vector<uint32> const* FindPostingList(AuctionIndexMap const& index, uint64 key)
+{
+    AuctionIndexMap::const_iterator itr = index.find(key);
+    return itr != index.end() ? &itr->second : NULL;
+}
+
+static uint64 NameTrigram(std::wstring const& name, size_t pos)
+{
+    return (uint64(name[pos] & 0x1FFFFF) << 42) | (uint64(name[pos + 1] & 0x1FFFFF) << 21) | uint64(name[pos + 2] & 0x1FFFFF);
+}
+
+// the lower case trigrams of a name, as Utf8FitTo() compares them
+static void AddNameTrigrams(std::string const& name, std::vector<uint64>& trigrams)
+{
+    std::wstring wname;
+    if (!Utf8toWStr(name, wname))
+        return;
+
+    wstrToLower(wname);
+    for (size_t i = 0; i + 2 < wname.size(); ++i)
+        trigrams.push_back(NameTrigram(wname, i));
+}
+
+// trigrams of the item name in every locale, with the random property suffix as ItemMatchesSearchCriteria() appends it
+static void GetNameTrigrams(ItemPrototype const* proto, int32 randomPropertyId, std::vector<uint64>& trigrams)
+{
+    std::string suffix;
+    if (randomPropertyId)
+        if (ItemRandomPropertiesEntry const* itemRandProp = sItemRandomPropertiesStore.LookupEntry(randomPropertyId))
+            if (DBCString temp = itemRandProp->nameSuffix)
+            {
+                suffix = " ";
+                suffix += temp;
+            }
+
+    AddNameTrigrams(std::string(proto->Name1) + suffix, trigrams);
+
+    if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
+        for (size_t i = 0; i < il->Name.size(); ++i)
+            if (!il->Name[i].empty())
+                AddNameTrigrams(il->Name[i] + suffix, trigrams);
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+// key of the sorted auction map of a sorting criterion, 0 (auction id order) for the others
+static uint64 GetAuctionSortKey(AuctionEntry const* auction, AuctionSortingCriterion criterion)
+{
+    switch (criterion)
+    {
+    case SC_RARITY:
+        return auction->GetItemQuality();
+    case SC_LEVEL:
+        return auction->GetRequiredLevel();
+    case SC_TIME_LEFT:
+        return uint64(auction->GetExpireTime());
+    case SC_CURRENT_BID:
+        return auction->bid ? auction->bid : auction->startbid;
+    default:
+        return 0;
+    }
+}
+
+struct AuctionSortKeyOrder
+{
+    bool operator()(std::pair<uint64, AuctionEntry const*> const& left, std::pair<uint64, AuctionEntry const*> const& right) const
+    {
+        return left.first < right.first;
+    }
+};
+
 
 
 AuctionSearch::AuctionSearch(Player* const player, std::wstring const& wsearchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
@@ -51,6 +158,13 @@ void AuctionHouseObject::AddAuction(AuctionEntry *auction)
     AuctionsMapBySeller.insert(std::make_pair(auction->GetOwnerName(), auction));
     AuctionsMapByCurrentBid.insert(std::make_pair(auction->startbid, auction));
 
+    int32 randomPropertyId = 0;
+    if (Item* item = sAuctionMgr->GetAItem(auction->item_guidlow))
+        randomPropertyId = item->GetItemRandomPropertyId();
+    if (randomPropertyId)
+        AuctionsRandomProperty[auction->Id] = randomPropertyId;
+    UpdateSearchIndexes(auction, randomPropertyId, true);
+
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
@@ -64,6 +178,15 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry *auction, uint32 /*itemEntry
         RemoveFromAuctionMap(AuctionsMapByTimeLeft, auction->GetExpireTime(), auction);
         RemoveFromAuctionMap(AuctionsMapBySeller, auction->GetOwnerName(), auction);
         RemoveFromAuctionMap(AuctionsMapByCurrentBid, auction->GetCurrentBid(), auction);
+
+        int32 randomPropertyId = 0;
+        std::unordered_map<uint32, int32>::iterator itr = AuctionsRandomProperty.find(auction->Id);
+        if (itr != AuctionsRandomProperty.end())
+        {
+            randomPropertyId = itr->second;
+            AuctionsRandomProperty.erase(itr);
+        }
+        UpdateSearchIndexes(auction, randomPropertyId, false);
     }
 
     sScriptMgr->OnAuctionRemove(this, auction);
@@ -99,31 +222,58 @@ void AuctionHouseObject::RemoveFromAuctionMap(TContainer &container, const TKey
     }
 }
 
-void AuctionHouseObject::Update()
+void AuctionHouseObject::UpdateSearchIndexes(AuctionEntry const* auction, int32 randomPropertyId, bool add)
 {
-    time_t curTime = sWorld->GetGameTime();
-    if (AuctionsMap.empty())
+    ItemPrototype const* proto = sObjectMgr->GetItemPrototype(auction->itemEntry);
+    if (!proto)
         return;
 
-    QueryResult result = CharacterDatabase.PQuery("SELECT id FROM auctionhouse WHERE time <= %u ORDER BY TIME ASC", (uint32)curTime + 60);
+    UpdatePostingList(AuctionsIndexByClass, (uint64(proto->Class) << 32) | proto->SubClass, auction->Id, add);
+    UpdatePostingList(AuctionsIndexByClass, (uint64(proto->Class) << 32) | 0xFFFFFFFF, auction->Id, add);
+    UpdatePostingList(AuctionsIndexByInventoryType, proto->InventoryType, auction->Id, add);
+    UpdatePostingList(AuctionsIndexByQuality, proto->Quality, auction->Id, add);
 
-    if (!result)
-        return;
-
-    do
-    {
-        FinishAuctionOnTime(result->Fetch()->GetUInt32());
-    } while (result->NextRow());
+    std::vector<uint64> trigrams;
+    GetNameTrigrams(proto, randomPropertyId, trigrams);
+    for (std::vector<uint64>::const_iterator itr = trigrams.begin(); itr != trigrams.end(); ++itr)
+        UpdatePostingList(AuctionsIndexByName, *itr, auction->Id, add);
 }
 
-void AuctionHouseObject::FinishAuctionOnTime(uint32 auctionId)
+void AuctionHouseObject::Update()
 {
-    AuctionEntry* auction = GetAuction(auctionId);
-    if (!auction)
+    // auctions ending before the next update (once a minute) are finished now
+    time_t expireTime = sWorld->GetGameTime() + 60;
+    if (AuctionsMapByTimeLeft.empty() || AuctionsMapByTimeLeft.begin()->first > expireTime)
         return;
 
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    uint32 count = 0;
+
+    while (!AuctionsMapByTimeLeft.empty() && AuctionsMapByTimeLeft.begin()->first <= expireTime)
+    {
+        AuctionEntry* auction = GetAuction(AuctionsMapByTimeLeft.begin()->second->Id);
+        if (!auction)
+        {
+            AuctionsMapByTimeLeft.erase(AuctionsMapByTimeLeft.begin());
+            continue;
+        }
+
+        // removes the auction from AuctionsMapByTimeLeft
+        FinishAuctionOnTime(auction, trans);
 
+        if (++count % AUCTION_EXPIRY_BATCH_SIZE == 0)
+        {
+            CharacterDatabase.CommitTransaction(trans);
+            trans = CharacterDatabase.BeginTransaction();
+        }
+    }
+
+    if (count % AUCTION_EXPIRY_BATCH_SIZE)
+        CharacterDatabase.CommitTransaction(trans);
+}
+
+void AuctionHouseObject::FinishAuctionOnTime(AuctionEntry* auction, SQLTransaction& trans)
+{
     ///- Either cancel the auction if there was no bidder
     if (auction->bidder == 0)
     {
@@ -145,10 +295,10 @@ void AuctionHouseObject::FinishAuctionOnTime(uint32 auctionId)
 
     ///- In any case clear the auction
     auction->DeleteFromDB(trans);
-    CharacterDatabase.CommitTransaction(trans);
 
+    uint32 itemGuid = auction->item_guidlow;
     RemoveAuction(auction, itemEntry);
-    sAuctionMgr->RemoveAItem(auction->item_guidlow);
+    sAuctionMgr->RemoveAItem(itemGuid);
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -293,56 +443,214 @@ bool AuctionHouseObject::ItemMatchesSearchCriteria(AuctionEntry const *Aentry, A
     return true;
 }
 
+// Intersects the posting lists of the indexed search criteria, returns false if the search has none of them.
+// The candidates are a superset of the result, ItemMatchesSearchCriteria() still checks each of them.
+bool AuctionHouseObject::GetSearchCandidates(AuctionSearch const& search, AuctionPostingList& candidates) const
+{
+    std::vector<AuctionPostingList const*> lists;
+    bool noMatch = false;
+
+    if (search.m_itemClass != 0xffffffff)
+    {
+        AuctionPostingList const* list = FindPostingList(AuctionsIndexByClass, (uint64(search.m_itemClass) << 32) | search.m_itemSubClass);
+        noMatch |= !list;
+        lists.push_back(list);
+    }
+
+    AuctionPostingList chestsAndRobes;
+    if (search.m_inventoryType != 0xffffffff)
+    {
+        AuctionPostingList const* list = FindPostingList(AuctionsIndexByInventoryType, search.m_inventoryType);
+
+        // chests are searched together with robes
+        if (search.m_inventoryType == INVTYPE_CHEST)
+            if (AuctionPostingList const* robes = FindPostingList(AuctionsIndexByInventoryType, INVTYPE_ROBE))
+            {
+                if (list)
+                    std::set_union(list->begin(), list->end(), robes->begin(), robes->end(), std::back_inserter(chestsAndRobes));
+                else
+                    chestsAndRobes = *robes;
+                list = &chestsAndRobes;
+            }
+
+        noMatch |= !list;
+        lists.push_back(list);
+    }
+
+    if (search.m_quality != 0xffffffff)
+    {
+        AuctionPostingList const* list = FindPostingList(AuctionsIndexByQuality, search.m_quality);
+        noMatch |= !list;
+        lists.push_back(list);
+    }
+
+    // a name shorter than a trigram can only be checked on the auctions themselves
+    for (size_t i = 0; i + 2 < search.m_wsearchedname.size() && !noMatch; ++i)
+    {
+        AuctionPostingList const* list = FindPostingList(AuctionsIndexByName, NameTrigram(search.m_wsearchedname, i));
+        noMatch |= !list;
+        lists.push_back(list);
+    }
+
+    if (noMatch)
+    {
+        candidates.clear();
+        return true;
+    }
+
+    // the level range is usually wide, it only narrows the search when nothing else does
+    if (lists.empty())
+    {
+        if (search.m_levelmin == 0x00)
+            return false;
+
+        candidates.clear();
+        if (search.m_levelmax != 0x00 && search.m_levelmax < search.m_levelmin)
+            return true;
+
+        std::multimap<uint32, const AuctionEntry*>::const_iterator begin = AuctionsMapByLevel.lower_bound(search.m_levelmin);
+        std::multimap<uint32, const AuctionEntry*>::const_iterator end = search.m_levelmax != 0x00 ? AuctionsMapByLevel.upper_bound(search.m_levelmax) : AuctionsMapByLevel.end();
+
+        for (std::multimap<uint32, const AuctionEntry*>::const_iterator itr = begin; itr != end; ++itr)
+            candidates.push_back(itr->second->Id);
+
+        std::sort(candidates.begin(), candidates.end());
+        return true;
+    }
+
+    // shortest list first, the intersection can only shrink
+    struct ShorterList
+    {
+        bool operator()(AuctionPostingList const* a, AuctionPostingList const* b) const { return a->size() < b->size(); }
+    };
+    std::sort(lists.begin(), lists.end(), ShorterList());
+
+    candidates = *lists[0];
+    AuctionPostingList intersection;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i)
+    {
+        intersection.clear();
+        std::set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(), std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    return true;
+}
+
 AuctionHouseObject::AuctionList AuctionHouseObject::GetAuctionsBySearchCriteria(const AuctionSearch &search) const
 {
+    AuctionPostingList candidates;
+    if (GetSearchCandidates(search, candidates))
+        return GetAuctionsBySearchCriteria(candidates, search);
+
     switch (search.m_sortingCriterion)
     {
     case SC_RARITY:
-        return GetAuctionsBySearchCriteria(AuctionsMapByRarity, search);
+        return GetAuctionsBySearchCriteria(AuctionsMapByRarity, search, NULL);
     case SC_LEVEL:
-        return GetAuctionsBySearchCriteria(AuctionsMapByLevel, search);
+        return GetAuctionsBySearchCriteria(AuctionsMapByLevel, search, NULL);
     case SC_TIME_LEFT:
-        return GetAuctionsBySearchCriteria(AuctionsMapByTimeLeft, search);
+        return GetAuctionsBySearchCriteria(AuctionsMapByTimeLeft, search, NULL);
     case SC_SELLER:
-        return GetAuctionsBySearchCriteria(AuctionsMapBySeller, search);
+        return GetAuctionsBySearchCriteria(AuctionsMapBySeller, search, NULL);
     case SC_CURRENT_BID:
-        return GetAuctionsBySearchCriteria(AuctionsMapByCurrentBid, search);
+        return GetAuctionsBySearchCriteria(AuctionsMapByCurrentBid, search, NULL);
     default:
-        return GetAuctionsBySearchCriteria(AuctionsMap, search);
+        return GetAuctionsBySearchCriteria(AuctionsMap, search, NULL);
     }
 }
 
+AuctionHouseObject::AuctionList AuctionHouseObject::GetAuctionsBySearchCriteria(AuctionPostingList const& candidates, const AuctionSearch &search) const
+{
+    // Sorting by seller needs the owner names, which may cost a database query each, and when the
+    // candidates are a large part of the auctions it is cheaper to pick them from the sorted map.
+    bool largeResult = candidates.size() * 8 > AuctionsMap.size();
+    switch (search.m_sortingCriterion)
+    {
+    case SC_RARITY:
+        if (largeResult)
+            return GetAuctionsBySearchCriteria(AuctionsMapByRarity, search, &candidates);
+        break;
+    case SC_LEVEL:
+        if (largeResult)
+            return GetAuctionsBySearchCriteria(AuctionsMapByLevel, search, &candidates);
+        break;
+    case SC_TIME_LEFT:
+        if (largeResult)
+            return GetAuctionsBySearchCriteria(AuctionsMapByTimeLeft, search, &candidates);
+        break;
+    case SC_SELLER:
+        return GetAuctionsBySearchCriteria(AuctionsMapBySeller, search, &candidates);
+    case SC_CURRENT_BID:
+        if (largeResult)
+            return GetAuctionsBySearchCriteria(AuctionsMapByCurrentBid, search, &candidates);
+        break;
+    default:
+        break;
+    }
+
+    std::vector<std::pair<uint64, AuctionEntry const*> > entries;
+    entries.reserve(candidates.size());
+    for (AuctionPostingList::const_iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
+        if (AuctionEntry const* entry = GetAuction(*itr))
+            entries.push_back(std::make_pair(GetAuctionSortKey(entry, search.m_sortingCriterion), entry));
+
+    std::stable_sort(entries.begin(), entries.end(), AuctionSortKeyOrder());
+
+    AuctionList result;
+    if (search.m_sortingDirection == SORT_ASC)
+    {
+        for (size_t i = 0; i < entries.size(); ++i)
+            AddSearchResult(entries[i].second, search, result);
+    }
+    else
+    {
+        for (size_t i = entries.size(); i > 0; --i)
+            AddSearchResult(entries[i - 1].second, search, result);
+    }
+
+    return result;
+}
+
 template <class TContainer>
-AuctionHouseObject::AuctionList AuctionHouseObject::GetAuctionsBySearchCriteria(TContainer &container, const AuctionSearch &search) const
+AuctionHouseObject::AuctionList AuctionHouseObject::GetAuctionsBySearchCriteria(TContainer &container, const AuctionSearch &search, AuctionPostingList const* candidates) const
 {
     if (search.m_sortingDirection == SORT_ASC)
-        return GetAuctionsBySearchCriteria(container.begin(), container.end(), search);
+        return GetAuctionsBySearchCriteria(container.begin(), container.end(), search, candidates);
     else
-        return GetAuctionsBySearchCriteria(container.rbegin(), container.rend(), search);
+        return GetAuctionsBySearchCriteria(container.rbegin(), container.rend(), search, candidates);
 }
 
 template <class TIterator>
-AuctionHouseObject::AuctionList AuctionHouseObject::GetAuctionsBySearchCriteria(const TIterator &begin, const TIterator &end, const AuctionSearch &search) const
+AuctionHouseObject::AuctionList AuctionHouseObject::GetAuctionsBySearchCriteria(const TIterator &begin, const TIterator &end, const AuctionSearch &search, AuctionPostingList const* candidates) const
 {
     AuctionList result;
 
     for (TIterator itr = begin; itr != end; itr++)
     {
         const AuctionEntry *entry = itr->second;
-        if (!ItemMatchesSearchCriteria(entry, search))
+        if (candidates && !std::binary_search(candidates->begin(), candidates->end(), entry->Id))
             continue;
 
-        if (search.m_count < 50 && search.m_totalcount >= search.m_listfrom)
-        {
-            ++search.m_count;
-            result.push_back(entry);
-        }
-        ++search.m_totalcount;
+        AddSearchResult(entry, search, result);
     }
 
     return result;
 }
 
+void AuctionHouseObject::AddSearchResult(AuctionEntry const* entry, AuctionSearch const& search, AuctionList& result) const
+{
+    if (!ItemMatchesSearchCriteria(entry, search))
+        return;
+
+    if (search.m_count < 50 && search.m_totalcount >= search.m_listfrom)
+    {
+        ++search.m_count;
+        result.push_back(entry);
+    }
+    ++search.m_totalcount;
+}
+
 void AuctionHouseObject::UpdateBidSorting(const AuctionEntry *auction, uint64 oldBid, uint64 newBid)
 {
     RemoveFromAuctionMap(AuctionsMapByCurrentBid, oldBid, auction);
@@ -1,6 +1,7 @@
 #ifndef _AUCTION_HOUSE_OBJECT_H
 #define _AUCTION_HOUSE_OBJECT_H
 
+#include "DatabaseEnv.h"
 
 // sorting values used by client in WorldSession::HandleAuctionListItems
 enum AuctionSortingCriterion
@@ -81,19 +82,35 @@ private:
     std::multimap<std::string, const AuctionEntry*> AuctionsMapBySeller;
     std::multimap<uint64 /*bid*/, const AuctionEntry*> AuctionsMapByCurrentBid;
 
-    void FinishAuctionOnTime(uint32 auctionId);
+    // Search indexes, a posting list holds the ids of the auctions with that key in ascending order.
+    // A search reads the postings of its criteria and only checks the auctions found in all of them.
+    typedef std::vector<uint32> AuctionPostingList;
+    typedef std::unordered_map<uint64, AuctionPostingList> AuctionIndex;
+    AuctionIndex AuctionsIndexByClass;                      // class << 32 | subclass, and class << 32 | 0xFFFFFFFF for the whole class
+    AuctionIndex AuctionsIndexByInventoryType;
+    AuctionIndex AuctionsIndexByQuality;
+    AuctionIndex AuctionsIndexByName;                       // trigrams of the lower case names in all locales, random property suffix included
+    std::unordered_map<uint32, int32> AuctionsRandomProperty;   // random property of the indexed item, the item may be gone when the auction is removed
+
+    void FinishAuctionOnTime(AuctionEntry* auction, SQLTransaction& trans);
     bool ItemMatchesSearchCriteria(AuctionEntry const *Aentry, AuctionSearch const& search) const;
 
     template <class TKey, class TContainer>
     void RemoveFromAuctionMap(TContainer &container, const TKey &key, const AuctionEntry *auction);
 
+    void UpdateSearchIndexes(AuctionEntry const* auction, int32 randomPropertyId, bool add);
+    bool GetSearchCandidates(AuctionSearch const& search, AuctionPostingList& candidates) const;
+
     AuctionList GetAuctionsBySearchCriteria(const AuctionSearch &search) const;
+    AuctionList GetAuctionsBySearchCriteria(AuctionPostingList const& candidates, const AuctionSearch &search) const;
 
     template <class TContainer>
-    AuctionList GetAuctionsBySearchCriteria(TContainer &container, const AuctionSearch &search) const;
+    AuctionList GetAuctionsBySearchCriteria(TContainer &container, const AuctionSearch &search, AuctionPostingList const* candidates) const;
 
     template <class TIterator>
-    AuctionList GetAuctionsBySearchCriteria(const TIterator &begin, const TIterator &end, const AuctionSearch &search) const;
+    AuctionList GetAuctionsBySearchCriteria(const TIterator &begin, const TIterator &end, const AuctionSearch &search, AuctionPostingList const* candidates) const;
+
+    void AddSearchResult(AuctionEntry const* entry, AuctionSearch const& search, AuctionList& result) const;
 };
 
 
@@ -2091,10 +2091,11 @@ void BattlegroundMgr::UpdateRatedBattlegroundWeek()
 
     CharacterDatabase.PExecute("UPDATE rated_battleground SET week = %u, next_week = %u", m_ratedBgWeek, m_ratedBgNextWeek);
 
-    //TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
-        itr->second->SendUpdateWorldState(RATED_BATTLEGROUND_WEEK_WORLDSTATE, m_ratedBgWeek);
+    HashMapHolder<Player>::ReadGuard guard;
+    std::vector<Player*> players;
+    sObjectAccessor->GetPlayers(players, guard);
+    for (std::vector<Player*>::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+        (*itr)->SendUpdateWorldState(RATED_BATTLEGROUND_WEEK_WORLDSTATE, m_ratedBgWeek);
 }
 
 BattlegroundTypeId BattlegroundMgr::GetRatedBattlegroundType()
@@ -676,12 +676,18 @@ ChatCommand * ChatHandler::getCommandTable()
     static ChatCommand serverCommandTable[] =
     {
         { "corpses",        SEC_GAMEMASTER,     true,  OldHandler<&ChatHandler::HandleServerCorpsesCommand>,       "", NULL },
+        { "database",       SEC_ADMINISTRATOR,  true,  OldHandler<&ChatHandler::HandleServerDatabaseCommand>,      "", NULL },
         { "exit",           SEC_CONSOLE,        true,  OldHandler<&ChatHandler::HandleServerExitCommand>,          "", NULL },
+        { "gscripts",       SEC_ADMINISTRATOR,  true,  OldHandler<&ChatHandler::HandleServerGScriptsCommand>,      "", NULL },
         { "idlerestart",    SEC_ADMINISTRATOR,  true,  NULL,                                           "", serverIdleRestartCommandTable },
         { "idleshutdown",   SEC_ADMINISTRATOR,  true,  NULL,                                           "", serverShutdownCommandTable },
         { "info",           SEC_PLAYER,         true,  OldHandler<&ChatHandler::HandleServerInfoCommand>,          "", NULL },
+        { "mapupdate",      SEC_ADMINISTRATOR,  true,  OldHandler<&ChatHandler::HandleServerMapUpdateCommand>,     "", NULL },
         { "motd",           SEC_PLAYER,         true,  OldHandler<&ChatHandler::HandleServerMotdCommand>,          "", NULL },
+        { "opcodes",        SEC_ADMINISTRATOR,  true,  OldHandler<&ChatHandler::HandleServerOpcodesCommand>,       "", NULL },
         { "plimit",         SEC_ADMINISTRATOR,  true,  OldHandler<&ChatHandler::HandleServerPLimitCommand>,        "", NULL },
+        { "registry",       SEC_ADMINISTRATOR,  true,  OldHandler<&ChatHandler::HandleServerRegistryCommand>,      "", NULL },
+        { "savestats",      SEC_ADMINISTRATOR,  true,  OldHandler<&ChatHandler::HandleServerSaveStatsCommand>,     "", NULL },
         { "destroy",        SEC_ADMINISTRATOR,  true,  OldHandler<&ChatHandler::HandleServerDestroyCommand>,       "", NULL },
         { "restart",        SEC_ADMINISTRATOR,  true,  NULL,                                           "", serverRestartCommandTable },
         { "shutdown",       SEC_ADMINISTRATOR,  true,  NULL,                                           "", serverShutdownCommandTable },
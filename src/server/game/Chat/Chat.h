@@ -532,6 +532,12 @@ class ChatHandler
         bool HandleServerShutDownCancelCommand(const char* args);
         bool HandleServerSetClosedCommand(const char* args);
         bool HandleServerDestroyCommand(const char* args);
+        bool HandleServerMapUpdateCommand(const char* args);
+        bool HandleServerOpcodesCommand(const char* args);
+        bool HandleServerSaveStatsCommand(const char* args);
+        bool HandleServerDatabaseCommand(const char* args);
+        bool HandleServerRegistryCommand(const char* args);
+        bool HandleServerGScriptsCommand(const char* args);
 
         bool HandleServerSetLogFileLevelCommand(const char* args);
         bool HandleServerSetDiffTimeCommand(const char* args);
@@ -393,13 +393,14 @@ bool ChatHandler::HandleGMListIngameCommand(const char* /*args*/)
 {
     bool first = true;
 
-    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, *HashMapHolder<Player>::GetLock(), true);
-    HashMapHolder<Player>::MapType &m = sObjectAccessor->GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        AccountTypes itr_sec = itr->second->GetSession()->GetSecurity();
-        if ((itr->second->IsGameMaster() || (itr_sec > SEC_PLAYER && itr_sec <= AccountTypes(sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_GM_LIST)))) &&
-            (!m_session || itr->second->IsVisibleGloballyFor(m_session->GetPlayer())))
+    HashMapHolder<Player>::ReadGuard guard;
+    std::vector<Player*> players;
+    sObjectAccessor->GetPlayers(players, guard);
+    for (std::vector<Player*>::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+    {
+        AccountTypes itr_sec = (*itr)->GetSession()->GetSecurity();
+        if (((*itr)->IsGameMaster() || (itr_sec > SEC_PLAYER && itr_sec <= AccountTypes(sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_GM_LIST)))) &&
+            (!m_session || (*itr)->IsVisibleGloballyFor(m_session->GetPlayer())))
         {
             if (first)
             {
@@ -407,7 +408,7 @@ bool ChatHandler::HandleGMListIngameCommand(const char* /*args*/)
                 first = false;
             }
 
-            SendSysMessage(GetNameLink(itr->second).c_str());
+            SendSysMessage(GetNameLink(*itr).c_str());
         }
     }
 
@@ -68,6 +68,7 @@
 #include "SmartAI.h"
 #include "ScriptDatabase.h"
 #include "GSMgr.h"
+#include "OpcodeStats.h"
 
 bool ChatHandler::HandleGuidspaceFlush(const char* args)
 {
@@ -1127,6 +1128,7 @@ bool ChatHandler::HandleReloadDisablesCommand(const char* /*arg*/)
     sDisableMgr->LoadDisables();
     sLog->outString("Checking quest disables...");
     sDisableMgr->CheckQuestDisables();
+    sAchievementMgr->BuildAchievementCriteriaUpdateLists();
     SendGlobalGMSysMessage("DB table `disables` reloaded.");
     return true;
 }
@@ -5241,10 +5243,11 @@ bool ChatHandler::HandleResetAllCommand(const char * args)
 
     CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE (at_login & '%u') = '0'",atLogin,atLogin);
 
-    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, *HashMapHolder<Player>::GetLock(), true);
-    HashMapHolder<Player>::MapType const& plist = sObjectAccessor->GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
-        itr->second->SetAtLoginFlag(atLogin);
+    HashMapHolder<Player>::ReadGuard guard;
+    std::vector<Player*> players;
+    sObjectAccessor->GetPlayers(players, guard);
+    for (std::vector<Player*>::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+        (*itr)->SetAtLoginFlag(atLogin);
 
     return true;
 }
@@ -6601,6 +6604,223 @@ bool ChatHandler::HandleServerPLimitCommand(const char *args)
     return true;
 }
 
+static bool CompareMapUpdateTime(Map const* a, Map const* b)
+{
+    return a->GetUpdateTimeEstimate() > b->GetUpdateTimeEstimate();
+}
+
+// .server mapupdate [count|reset] - map updater thread load and the most expensive maps (times in microseconds)
+bool ChatHandler::HandleServerMapUpdateCommand(const char *args)
+{
+    MapUpdater* updater = sMapMgr->GetMapUpdater();
+    if (!updater->activated())
+    {
+        SendSysMessage("Map updater threads are not active (MapUpdate.Threads = 0).");
+        return true;
+    }
+
+    std::vector<Map*> maps;
+    sMapMgr->GetAllMaps(maps);
+
+    if (*args && strncmp(args, "reset", strlen(args)) == 0)
+    {
+        updater->ResetStats();
+        for (std::vector<Map*>::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+            (*itr)->ResetUpdateTimeMax();
+        SendSysMessage("Map updater statistics reset.");
+        return true;
+    }
+
+    uint32 count = *args ? uint32(atoi(args)) : 10;
+
+    PSendSysMessage("Map update tick: last %u, max %u", updater->GetLastTickTime(), updater->GetMaxTickTime());
+
+    std::vector<MapUpdaterThreadStats> threads;
+    updater->GetThreadStats(threads);
+    for (uint32 i = 0; i < threads.size(); ++i)
+        PSendSysMessage("Thread %u: %u updates (%u stolen), busy " UI64FMTD, i, threads[i].updates, threads[i].steals, threads[i].busyTime);
+
+    std::sort(maps.begin(), maps.end(), CompareMapUpdateTime);
+    if (count > maps.size())
+        count = maps.size();
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        Map const* map = maps[i];
+        PSendSysMessage("Map %u (%s) instance %u: avg %u, last %u, max %u, players %u", map->GetId(), map->GetMapName(),
+            map->GetInstanceId(), map->GetUpdateTimeEstimate(), map->GetLastUpdateTime(), map->GetMaxUpdateTime(), map->GetPlayers().getSize());
+    }
+
+    return true;
+}
+
+struct OpcodeCountersOrder
+{
+    OpcodeCountersOrder(OpcodeCountersList const& totals, bool byTime) : m_totals(totals), m_byTime(byTime) {}
+
+    bool operator()(uint32 a, uint32 b) const
+    {
+        OpcodeCounters const& left = m_totals[a];
+        OpcodeCounters const& right = m_totals[b];
+        if (m_byTime)
+            return left.handlerTime > right.handlerTime;
+        return left.sentBytes + left.receivedBytes > right.sentBytes + right.receivedBytes;
+    }
+
+    OpcodeCountersList const& m_totals;
+    bool m_byTime;
+};
+
+// .server opcodes [bytes|time|reset] [count] - opcodes with the most traffic or handler time (microseconds) since the last reset
+bool ChatHandler::HandleServerOpcodesCommand(const char *args)
+{
+    char* mode = strtok((char*)args, " ");
+    char* countStr = strtok(NULL, " ");
+
+    if (mode && strncmp(mode, "reset", strlen(mode)) == 0)
+    {
+        sOpcodeStats->Reset();
+        SendSysMessage("Opcode statistics reset.");
+        return true;
+    }
+
+    // a number alone is the count
+    if (mode && isdigit(*mode))
+    {
+        countStr = mode;
+        mode = NULL;
+    }
+
+    bool byTime = mode && strncmp(mode, "time", strlen(mode)) == 0;
+    uint32 count = countStr ? uint32(atoi(countStr)) : 10;
+
+    OpcodeCountersList totals;
+    sOpcodeStats->GetTotals(totals);
+
+    std::vector<uint32> opcodes;
+    for (uint32 i = 0; i < totals.size(); ++i)
+        if (!totals[i].IsEmpty())
+            opcodes.push_back(i);
+
+    std::sort(opcodes.begin(), opcodes.end(), OpcodeCountersOrder(totals, byTime));
+
+    if (count > opcodes.size())
+        count = opcodes.size();
+
+    PSendSysMessage("%u opcodes seen, top %u by %s:", uint32(opcodes.size()), count, byTime ? "handler time" : "bytes");
+    for (uint32 i = 0; i < count; ++i)
+    {
+        OpcodeCounters const& counters = totals[opcodes[i]];
+        PSendSysMessage("%s (0x%04X): sent " UI64FMTD " (" UI64FMTD " bytes, " UI64FMTD " compressed), received " UI64FMTD " (" UI64FMTD " bytes), handler " UI64FMTD " us in " UI64FMTD " calls",
+            LookupOpcodeName(opcodes[i]), opcodes[i], counters.sentCount, counters.sentBytes, counters.compressedBytes,
+            counters.receivedCount, counters.receivedBytes, counters.handlerTime, counters.handledCount);
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandleServerSaveStatsCommand(const char *args)
+{
+    if (*args && strncmp(args, "reset", strlen(args)) == 0)
+    {
+        sPlayerSaveStats->Reset();
+        SendSysMessage("Player save statistics reset.");
+        return true;
+    }
+
+    uint64 saves = sPlayerSaveStats->GetSaves();
+    uint64 statements = sPlayerSaveStats->GetStatements();
+    PSendSysMessage("Player saves: " UI64FMTD ", " UI64FMTD " statements (%.1f per save)",
+        saves, statements, saves ? float(statements) / saves : 0.0f);
+
+    for (uint8 i = 0; i < MAX_PLAYER_SAVE_SECTIONS; ++i)
+    {
+        PlayerSaveSection section = PlayerSaveSection(i);
+        PSendSysMessage("    %-24s written " UI64FMTD ", skipped as unchanged " UI64FMTD,
+            PlayerSaveStats::GetSectionName(section), sPlayerSaveStats->GetWritten(section), sPlayerSaveStats->GetSkipped(section));
+    }
+
+    return true;
+}
+
+template <class T>
+static void SendDatabaseQueueInfo(ChatHandler* handler, char const* name, DatabaseWorkerPool<T>& pool)
+{
+    DatabaseGroupCommit const& groupCommit = pool.GetGroupCommit();
+    handler->PSendSysMessage("%s: %u queued", name, uint32(pool.GetQueueSize()));
+    if (!groupCommit.IsEnabled())
+        return;
+
+    uint64 groups = groupCommit.groups.value();
+    uint64 grouped = groupCommit.grouped.value();
+    handler->PSendSysMessage("    group commit (%u writes, %u ms): " UI64FMTD " writes, " UI64FMTD " groups of %.1f on average, largest %u, " UI64FMTD " retried one by one",
+        groupCommit.maxOperations, groupCommit.maxDelay, groupCommit.operations.value(), groups,
+        groups ? float(grouped) / groups : 0.0f, groupCommit.largest.value(), groupCommit.retried.value());
+}
+
+bool ChatHandler::HandleServerDatabaseCommand(const char* /*args*/)
+{
+    SendDatabaseQueueInfo(this, "WorldDatabase", WorldDatabase);
+    SendDatabaseQueueInfo(this, "CharacterDatabase", CharacterDatabase);
+    SendDatabaseQueueInfo(this, "LoginDatabase", LoginDatabase);
+    return true;
+}
+
+template <class T>
+static void SendRegistryInfo(ChatHandler* handler, char const* name)
+{
+    handler->PSendSysMessage("    %-16s %8u objects, waited on a lock: " UI64FMTD " lookups, " UI64FMTD " inserts or removes",
+        name, HashMapHolder<T>::GetCount(), HashMapHolder<T>::GetContendedReads(), HashMapHolder<T>::GetContendedWrites());
+}
+
+bool ChatHandler::HandleServerRegistryCommand(const char* /*args*/)
+{
+    PSendSysMessage("Object registry, %u shards per type:", uint32(HashMapHolder<Player>::SHARD_COUNT));
+    SendRegistryInfo<Player>(this, "Player");
+    SendRegistryInfo<Creature>(this, "Creature");
+    SendRegistryInfo<Pet>(this, "Pet");
+    SendRegistryInfo<GameObject>(this, "GameObject");
+    SendRegistryInfo<DynamicObject>(this, "DynamicObject");
+    SendRegistryInfo<Corpse>(this, "Corpse");
+    return true;
+}
+
+struct GScriptTimeOrder
+{
+    bool operator()(std::pair<int, CommandContainer*> const& a, std::pair<int, CommandContainer*> const& b) const
+    {
+        return a.second->exec_time.value() > b.second->exec_time.value();
+    }
+};
+
+bool ChatHandler::HandleServerGScriptsCommand(const char* args)
+{
+    uint32 count = *args ? uint32(atoi(args)) : 10;
+
+    if (!sWorld->getBoolConfig(CONFIG_GSCRIPT_PROFILING))
+        SendSysMessage("G-Script profiling is disabled (GScript.Profiling), the counters are not updated.");
+
+    std::map<int, CommandContainer*> const& loaded = sGSMgr->GetLoadedScripts();
+    std::vector<std::pair<int, CommandContainer*> > scripts;
+    for (std::map<int, CommandContainer*>::const_iterator itr = loaded.begin(); itr != loaded.end(); ++itr)
+        if (itr->second)
+            scripts.push_back(*itr);
+
+    std::sort(scripts.begin(), scripts.end(), GScriptTimeOrder());
+    if (scripts.size() > count)
+        scripts.resize(count);
+
+    PSendSysMessage("G-Scripts by execution time since loaded, %u shown:", uint32(scripts.size()));
+    for (std::vector<std::pair<int, CommandContainer*> >::const_iterator itr = scripts.begin(); itr != scripts.end(); ++itr)
+    {
+        uint64 executed = itr->second->executed.value();
+        uint64 time = itr->second->exec_time.value();
+        PSendSysMessage("    script %6d: %4u commands, " UI64FMTD " executed, " UI64FMTD " us (%.2f us each)",
+            itr->first, uint32(itr->second->command_vector.size()), executed, time, executed ? float(time) / executed : 0.0f);
+    }
+    return true;
+}
+
 bool ChatHandler::HandleCastCommand(const char *args)
 {
     if (!*args)
@@ -225,8 +225,7 @@ bool Condition::Meets(Player * player, Unit* invoker)
     bool refMeets = false;
     if (condMeets && refId)//only have to check references if 'this' is met
     {
-        ConditionList ref = sConditionMgr->GetConditionReferences(refId);
-        refMeets = sConditionMgr->IsPlayerMeetToConditions(player, ref);
+        refMeets = sConditionMgr->IsPlayerMeetToConditions(player, sConditionMgr->GetConditionReferences(refId));
     }
     else
         refMeets = true;
@@ -247,36 +246,46 @@ ConditionMgr::~ConditionMgr()
     Clean();
 }
 
-ConditionList ConditionMgr::GetConditionReferences(uint32 refId)
+ConditionList const& ConditionMgr::GetConditionReferences(uint32 refId) const
 {
-    ConditionList conditions;
     ConditionReferenceMap::const_iterator ref = m_ConditionReferenceMap.find(refId);
     if (ref != m_ConditionReferenceMap.end())
-        conditions = (*ref).second;
-    return conditions;
+        return ref->second;
+    return m_EmptyConditionList;
 }
 
-bool ConditionMgr::IsPlayerMeetToConditionList(Player* player,const ConditionList& conditions, Unit* invoker)
+void ConditionMgr::AddToConditionList(ConditionList& conditions, Condition* cond)
 {
-    std::map<uint32, bool>ElseGroupMap;
-    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
+    // insert after the conditions of the same ElseGroup, keeping their order
+    ConditionList::iterator itr = conditions.end();
+    while (itr != conditions.begin() && (*(itr - 1))->mElseGroup > cond->mElseGroup)
+        --itr;
+    conditions.insert(itr, cond);
+}
+
+bool ConditionMgr::IsPlayerMeetToConditionList(Player* player, ConditionList const& conditions, Unit* invoker)
+{
+    // the list is ordered by ElseGroup: all loaded conditions of one group must be met, one group met is enough
+    ConditionList::const_iterator i = conditions.begin();
+    while (i != conditions.end())
     {
-        sLog->outDebug("ConditionMgr::IsPlayerMeetToConditionList condType: %u val1: %u",(*i)->mConditionType,(*i)->mConditionValue1);
-        if ((*i)->isLoaded())
+        uint32 elseGroup = (*i)->mElseGroup;
+        bool hasConditions = false;
+        bool groupMeets = true;
+        for (; i != conditions.end() && (*i)->mElseGroup == elseGroup; ++i)
         {
-            std::map<uint32, bool>::const_iterator itr = ElseGroupMap.find((*i)->mElseGroup);
-            if (itr == ElseGroupMap.end())
-                ElseGroupMap[(*i)->mElseGroup] = true;
-            else if (!(*itr).second)
+            sLog->outDebug("ConditionMgr::IsPlayerMeetToConditionList condType: %u val1: %u",(*i)->mConditionType,(*i)->mConditionValue1);
+            if (!groupMeets || !(*i)->isLoaded())
                 continue;
 
+            hasConditions = true;
             if ((*i)->mReferenceId)//handle reference
             {
                 ConditionReferenceMap::const_iterator ref = m_ConditionReferenceMap.find((*i)->mReferenceId);
                 if (ref != m_ConditionReferenceMap.end())
                 {
-                    if(!IsPlayerMeetToConditionList(player, (*ref).second, invoker))
-                        ElseGroupMap[(*i)->mElseGroup] = false;
+                    if (!IsPlayerMeetToConditionList(player, (*ref).second, invoker))
+                        groupMeets = false;
                 }
                 else
                 {
@@ -288,18 +297,18 @@ bool ConditionMgr::IsPlayerMeetToConditionList(Player* player,const ConditionLis
             else //handle normal condition
             {
                 if (!(*i)->Meets(player, invoker))
-                    ElseGroupMap[(*i)->mElseGroup] = false;
+                    groupMeets = false;
             }
         }
-    }
-    for (std::map<uint32, bool>::const_iterator i = ElseGroupMap.begin(); i != ElseGroupMap.end(); ++i)
-        if (i->second)
+
+        if (hasConditions && groupMeets)
             return true;
+    }
 
     return false;
 }
 
-bool ConditionMgr::IsPlayerMeetToConditions(Player* player, ConditionList conditions, Unit* invoker)
+bool ConditionMgr::IsPlayerMeetToConditions(Player* player, ConditionList const& conditions, Unit* invoker)
 {
     if (conditions.empty())
         return true;
@@ -316,54 +325,30 @@ bool ConditionMgr::IsPlayerMeetToConditions(Player* player, ConditionList condit
     return result;
 }
 
-ConditionList ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sType, uint32 uEntry)
+ConditionList const& ConditionMgr::GetConditions(ConditionSourceType sType, uint32 group, uint32 entry) const
 {
-    ConditionList spellCond;
     if (sType > CONDITION_SOURCE_TYPE_NONE && sType < CONDITION_SOURCE_TYPE_MAX)
     {
-        ConditionMap::const_iterator itr = m_ConditionMap.find(sType);
-        if (itr != m_ConditionMap.end())
-        {
-            ConditionTypeMap::const_iterator i = (*itr).second.find(uEntry);
-            if (i != (*itr).second.end())
-            {
-                spellCond = (*i).second;
-                sLog->outDebug("GetConditionsForNotGroupedEntry: found conditions for type %u and entry %u", uint32(sType), uEntry);
-            }
-        }
+        ConditionContainer::const_iterator itr = m_ConditionStore[sType].find(MAKE_PAIR64(entry, group));
+        if (itr != m_ConditionStore[sType].end())
+            return itr->second;
     }
-    return spellCond;
+    return m_EmptyConditionList;
 }
 
-ConditionList ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureID, uint32 spellID)
+ConditionList const& ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sType, uint32 uEntry) const
 {
-    ConditionList cond;
-    VehicleSpellConditionMap::const_iterator itr = m_VehicleSpellConditions.find(creatureID);
-    if (itr != m_VehicleSpellConditions.end())
-    {
-        ConditionTypeMap::const_iterator i = (*itr).second.find(spellID);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-            sLog->outDebug("GetConditionsForVehicleSpell: found conditions for Vehicle entry %u spell %u", creatureID, spellID);
-        }
-    }
-    return cond;
+    return GetConditions(sType, 0, uEntry);
 }
 
-ConditionList ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureID, uint32 itemID)
+ConditionList const& ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureID, uint32 spellID) const
 {
-    ConditionList cond;
-    NpcVendorConditionMap::const_iterator itr = m_NpcVendorConditions.find(creatureID);
-    if (itr != m_NpcVendorConditions.end())
-    {
-        ConditionTypeMap::const_iterator i = (*itr).second.find(itemID);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-        }
-    }
-    return cond;
+    return GetConditions(CONDITION_SOURCE_TYPE_VEHICLE_SPELL, creatureID, spellID);
+}
+
+ConditionList const& ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureID, uint32 itemID) const
+{
+    return GetConditions(CONDITION_SOURCE_TYPE_NPC_VENDOR, creatureID, itemID);
 }
 
 void ConditionMgr::LoadConditions(bool isReload)
@@ -458,12 +443,7 @@ void ConditionMgr::LoadConditions(bool isReload)
         if (iSourceTypeOrReferenceId < 0)//it is a reference template
         {
             uint32 uRefId = abs(iSourceTypeOrReferenceId);
-            if (m_ConditionReferenceMap.find(uRefId) == m_ConditionReferenceMap.end())//make sure we have a list for our conditions, based on reference id
-            {
-                ConditionList mCondList;
-                m_ConditionReferenceMap[uRefId] = mCondList;
-            }
-            m_ConditionReferenceMap[uRefId].push_back(cond);//add to reference storage
+            AddToConditionList(m_ConditionReferenceMap[uRefId], cond);//add to reference storage
             count++;
             continue;
         }//end of reference templates
@@ -533,30 +513,11 @@ void ConditionMgr::LoadConditions(bool isReload)
                     bIsDone = addToGossipMenuItems(cond);
                     break;
                 case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
-                {
-                    //if no list for vehicle create one
-                    if (m_VehicleSpellConditions.find(cond->mSourceGroup) == m_VehicleSpellConditions.end())
-                    {
-                        ConditionTypeMap cmap;
-                        m_VehicleSpellConditions[cond->mSourceGroup] = cmap;
-                    }
-                    //if no list for vehicle's spell create one
-                    if (m_VehicleSpellConditions[cond->mSourceGroup].find(cond->mSourceEntry) == m_VehicleSpellConditions[cond->mSourceGroup].end())
-                    {
-                        ConditionList clist;
-                        m_VehicleSpellConditions[cond->mSourceGroup][cond->mSourceEntry] = clist;
-                    }
-                    m_VehicleSpellConditions[cond->mSourceGroup][cond->mSourceEntry].push_back(cond);
-                    bIsDone = true;
-                    ++count;
-                    continue;   // do not add to m_AllocatedMemory to avoid double deleting
-                }
                 case CONDITION_SOURCE_TYPE_NPC_VENDOR:
                 {
-                    m_NpcVendorConditions[cond->mSourceGroup][cond->mSourceEntry].push_back(cond);
-                    bIsDone = true;
+                    AddToConditionList(m_ConditionStore[cond->mSourceType][MAKE_PAIR64(cond->mSourceEntry, cond->mSourceGroup)], cond);
                     ++count;
-                    continue;
+                    continue;   // do not add to m_AllocatedMemory to avoid double deleting
                 }
                 default:
                     break;
@@ -576,22 +537,8 @@ void ConditionMgr::LoadConditions(bool isReload)
         }
 
         //handle not grouped conditions
-        //make sure we have a storage list for our SourceType
-        if (m_ConditionMap.find(cond->mSourceType) == m_ConditionMap.end())
-        {
-            ConditionTypeMap mTypeMap;
-            m_ConditionMap[cond->mSourceType] = mTypeMap;//add new empty list for SourceType
-        }
-
-        //make sure we have a condition list for our SourceType's entry
-        if (m_ConditionMap[cond->mSourceType].find(cond->mSourceEntry) == m_ConditionMap[cond->mSourceType].end())
-        {
-            ConditionList mCondList;
-            m_ConditionMap[cond->mSourceType][cond->mSourceEntry] = mCondList;
-        }
-
         //add new Condition to storage based on Type/Entry
-        m_ConditionMap[cond->mSourceType][cond->mSourceEntry].push_back(cond);
+        AddToConditionList(m_ConditionStore[cond->mSourceType][MAKE_PAIR64(cond->mSourceEntry, 0)], cond);
         ++count;
     }
     while (result->NextRow());
@@ -625,7 +572,7 @@ bool ConditionMgr::addToGossipMenus(Condition* cond)
         {
             if ((*itr).second.entry == cond->mSourceGroup && (*itr).second.text_id == cond->mSourceEntry)
             {
-                (*itr).second.conditions.push_back(cond);
+                AddToConditionList((*itr).second.conditions, cond);
                 return true;
             }
         }
@@ -644,7 +591,7 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond)
         {
             if ((*itr).second.menu_id == cond->mSourceGroup && (*itr).second.id == cond->mSourceEntry)
             {
-                (*itr).second.conditions.push_back(cond);
+                AddToConditionList((*itr).second.conditions, cond);
                 return true;
             }
         }
@@ -1428,46 +1375,15 @@ void ConditionMgr::Clean()
 
     m_ConditionReferenceMap.clear();
 
-    for (ConditionMap::iterator itr = m_ConditionMap.begin(); itr != m_ConditionMap.end(); ++itr)
-    {
-        for (ConditionTypeMap::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    m_ConditionMap.clear();
-
-    
-    for (VehicleSpellConditionMap::iterator itr = m_VehicleSpellConditions.begin(); itr != m_VehicleSpellConditions.end(); ++itr)
+    for (uint32 sourceType = 0; sourceType < CONDITION_SOURCE_TYPE_MAX; ++sourceType)
     {
-        for (ConditionTypeMap::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
+        for (ConditionContainer::iterator itr = m_ConditionStore[sourceType].begin(); itr != m_ConditionStore[sourceType].end(); ++itr)
+            for (ConditionList::const_iterator i = itr->second.begin(); i != itr->second.end(); ++i)
                 delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
 
-    m_VehicleSpellConditions.clear();
-
-    for (NpcVendorConditionMap::iterator itr = m_NpcVendorConditions.begin(); itr != m_NpcVendorConditions.end(); ++itr)
-    {
-        for (ConditionTypeMap::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
+        m_ConditionStore[sourceType].clear();
     }
 
-    m_NpcVendorConditions.clear();
-
     // this is a BIG hack, feel free to fix it if you can figure out the ConditionMgr ;)
     for (std::list<Condition*>::const_iterator itr = m_AllocatedMemory.begin(); itr != m_AllocatedMemory.end(); ++itr)
         delete *itr;
@@ -139,13 +139,11 @@ struct Condition
     bool isLoaded() const { return mConditionType > CONDITION_NONE || mReferenceId; }
 };
 
+// kept ordered by ElseGroup (see ConditionMgr::AddToConditionList), each ElseGroup is a contiguous run
 typedef std::vector<Condition*> ConditionList;
-typedef std::map<uint32, ConditionList > ConditionTypeMap;
-typedef std::map<ConditionSourceType, ConditionTypeMap > ConditionMap;
-typedef std::map<uint32, ConditionTypeMap > VehicleSpellConditionMap;
-typedef std::map<uint32, ConditionTypeMap > NpcVendorConditionMap;
+typedef std::unordered_map<uint64, ConditionList > ConditionContainer;//by MAKE_PAIR64(SourceEntry, SourceGroup)
 
-typedef std::map<uint32, ConditionList > ConditionReferenceMap;//only used for references
+typedef std::unordered_map<uint32, ConditionList > ConditionReferenceMap;//only used for references
 
 class ConditionMgr
 {
@@ -157,19 +155,21 @@ class ConditionMgr
 
         void LoadConditions(bool isReload = false);
         bool isConditionTypeValid(Condition* cond);
-        ConditionList GetConditionReferences(uint32 refId);
+        ConditionList const& GetConditionReferences(uint32 refId) const;
 
-        bool IsPlayerMeetToConditions(Player* player, ConditionList conditions, Unit* invoker = NULL);
-        ConditionList GetConditionsForNotGroupedEntry(ConditionSourceType sType, uint32 uEntry);
-        ConditionList GetConditionsForVehicleSpell(uint32 creatureID, uint32 spellID);
-        ConditionList GetConditionsForNpcVendorEvent(uint32 creatureID, uint32 itemID);
+        bool IsPlayerMeetToConditions(Player* player, ConditionList const& conditions, Unit* invoker = NULL);
+        ConditionList const& GetConditionsForNotGroupedEntry(ConditionSourceType sType, uint32 uEntry) const;
+        ConditionList const& GetConditionsForVehicleSpell(uint32 creatureID, uint32 spellID) const;
+        ConditionList const& GetConditionsForNpcVendorEvent(uint32 creatureID, uint32 itemID) const;
+
+        // every list the conditions are evaluated from must be filled with this
+        static void AddToConditionList(ConditionList& conditions, Condition* cond);
 
     protected:
 
-        ConditionMap                m_ConditionMap;
+        ConditionContainer          m_ConditionStore[CONDITION_SOURCE_TYPE_MAX];
         ConditionReferenceMap       m_ConditionReferenceMap;
-        VehicleSpellConditionMap    m_VehicleSpellConditions;
-        NpcVendorConditionMap       m_NpcVendorConditions;
+        ConditionList               m_EmptyConditionList;
 
     private:
 
@@ -177,7 +177,8 @@ class ConditionMgr
         bool addToLootTemplate(Condition* cond, LootTemplate* loot);
         bool addToGossipMenus(Condition* cond);
         bool addToGossipMenuItems(Condition* cond);
-        bool IsPlayerMeetToConditionList(Player* player,const ConditionList& conditions, Unit* invoker = NULL);
+        bool IsPlayerMeetToConditionList(Player* player, ConditionList const& conditions, Unit* invoker = NULL);
+        ConditionList const& GetConditions(ConditionSourceType sType, uint32 group, uint32 entry) const;
 
         bool isGroupable(ConditionSourceType sourceType) const
         {
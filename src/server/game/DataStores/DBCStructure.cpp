@@ -126,7 +126,8 @@ void SpellEntry::LoadSpellAddons()
     
     for(int i = 0; i < 3; i++)
     {
-        SpellEffectEntry const* SpellEffect = GetSpellEffect(i);
+        effectEntries[i] = GetSpellEffectEntry(Id, i);
+        SpellEffectEntry const* SpellEffect = effectEntries[i];
         Effect[i] = SpellEffect ? SpellEffect->Effect : 0;
         EffectValueMultiplier[i] = SpellEffect ? SpellEffect->EffectValueMultiplier : 0;
         EffectApplyAuraName[i] = SpellEffect ? SpellEffect->EffectApplyAuraName : 0;
@@ -215,14 +216,14 @@ void SpellEntry::LoadSpellAddons()
 
 int32 SpellEntry::CalculateSimpleValue(uint32 eff) const
 {
-    if(SpellEffectEntry const* effectEntry = GetSpellEffectEntry(Id, eff))
+    if(SpellEffectEntry const* effectEntry = GetSpellEffect(eff))
         return effectEntry->EffectBasePoints;
     return 0;
 }
 
 uint32 const* SpellEntry::GetEffectSpellClassMask(uint32 eff) const
 {
-    if(SpellEffectEntry const* effectEntry = GetSpellEffectEntry(Id, eff))
+    if(SpellEffectEntry const* effectEntry = GetSpellEffect(eff))
         return &effectEntry->EffectSpellClassMask[0];
     return NULL;
 }
@@ -259,7 +260,7 @@ SpellCooldownsEntry const* SpellEntry::GetSpellCooldowns() const
 
 SpellEffectEntry const* SpellEntry::GetSpellEffect(uint32 eff) const
 {
-    return GetSpellEffectEntry(Id, eff);
+    return eff < MAX_SPELL_EFFECTS ? effectEntries[eff] : NULL;
 }
 
 SpellEquippedItemsEntry const* SpellEntry::GetSpellEquippedItems() const
@@ -2243,6 +2243,9 @@ struct SpellEntry
     bool HasSpellEffect(uint32 effectId) const;
 
 private:
+    // SpellEffect.dbc rows of this spell, resolved once at load instead of a SpellEffectMap lookup per access
+    SpellEffectEntry const* effectEntries[MAX_SPELL_EFFECTS];
+
     // prevent creating custom entries (copy data from original in fact)
     SpellEntry(SpellEntry const&);                      // DON'T must have implementation
 };
@@ -287,22 +287,18 @@ void LFGMgr::Update(uint32 diff)
     {
         uint8 queueId = it->first;
         LfgGuidList& newToQueue = it->second;
-        LfgGuidList& currentQueue = m_currentQueue[queueId];
-        LfgGuidList firstNew;
         while (!newToQueue.empty())
         {
             uint64 frontguid = newToQueue.front();
-            sLog->outDebug("LFGMgr::Update: QueueId %u: checking [" UI64FMTD "] newToQueue(%u), currentQueue(%u)", queueId, frontguid, uint32(newToQueue.size()), uint32(currentQueue.size()));
-            firstNew.push_back(frontguid);
+            sLog->outDebug("LFGMgr::Update: QueueId %u: checking [" UI64FMTD "] newToQueue(%u), dungeonQueues(%u)", queueId, frontguid, uint32(newToQueue.size()), uint32(m_DungeonQueues[queueId].size()));
             newToQueue.pop_front();
 
-            LfgGuidList temporalList = currentQueue;
-            if (LfgProposal* pProposal = FindNewGroups(firstNew, temporalList)) // Group found!
+            if (LfgProposal* pProposal = FindNewGroup(frontguid, queueId)) // Group found!
             {
-                // Remove groups in the proposal from new and current queues (not from queue map)
+                // Remove groups in the proposal from new and dungeon queues (not from queue map)
                 for (LfgGuidList::const_iterator itQueue = pProposal->queues.begin(); itQueue != pProposal->queues.end(); ++itQueue)
                 {
-                    currentQueue.remove(*itQueue);
+                    RemoveFromDungeonQueues(*itQueue, queueId);
                     newToQueue.remove(*itQueue);
                 }
                 m_Proposals[++m_lfgProposalId] = pProposal;
@@ -331,8 +327,7 @@ void LFGMgr::Update(uint32 diff)
                     UpdateProposal(m_lfgProposalId, guid, true);
             }
             else
-                currentQueue.push_back(frontguid);         // Lfg group not found, add this group to the queue.
-            firstNew.clear();
+                AddToDungeonQueues(frontguid, queueId);    // Lfg group not found, add this group to the queue.
         }
     }
 
@@ -341,6 +336,8 @@ void LFGMgr::Update(uint32 diff)
     {
         m_QueueTimer = 0;
         time_t currTime = time(NULL);
+        LfgRoleCountMap roleCounts;
+        GetRoleCountsInDungeonQueues(roleCounts);
         for (LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.begin(); itQueue != m_QueueInfoMap.end(); ++itQueue)
         {
             LfgQueueInfo* queue = itQueue->second;
@@ -384,20 +381,10 @@ void LFGMgr::Update(uint32 diff)
 
             if (src)
             {
-                tanks = GetRoleCountInDungeonQueue(dungeonId, ROLE_TANK, src->GetTeam());
-                healers = GetRoleCountInDungeonQueue(dungeonId, ROLE_HEALER, src->GetTeam());
-                dpss = GetRoleCountInDungeonQueue(dungeonId, ROLE_DAMAGE, src->GetTeam());
-
-                if (tanks > LFG_TANKS_NEEDED)
-                    tanks = LFG_TANKS_NEEDED;
-                if (healers > LFG_HEALERS_NEEDED)
-                    healers = LFG_HEALERS_NEEDED;
-                if (dpss > LFG_DPS_NEEDED)
-                    dpss = LFG_DPS_NEEDED;
-
-                tanks   = LFG_TANKS_NEEDED - tanks;
-                healers = LFG_HEALERS_NEEDED - healers;
-                dpss    = LFG_DPS_NEEDED - dpss;
+                const LfgRoleCount& count = roleCounts[MAKE_PAIR64(dungeonId, src->GetTeam())];
+                tanks   = LFG_TANKS_NEEDED - uint8(std::min<uint32>(count.tanks, LFG_TANKS_NEEDED));
+                healers = LFG_HEALERS_NEEDED - uint8(std::min<uint32>(count.healers, LFG_HEALERS_NEEDED));
+                dpss    = LFG_DPS_NEEDED - uint8(std::min<uint32>(count.dps, LFG_DPS_NEEDED));
             }
 
             for (LfgRolesMap::const_iterator itPlayer = queue->roles.begin(); itPlayer != queue->roles.end(); ++itPlayer)
@@ -441,14 +428,12 @@ void LFGMgr::AddToQueue(const uint64& guid, uint8 queueId)
 */
 bool LFGMgr::RemoveFromQueue(const uint64& guid)
 {
-    for (LfgGuidListMap::iterator it = m_currentQueue.begin(); it != m_currentQueue.end(); ++it)
-        it->second.remove(guid);
+    for (std::map<uint8, LfgDungeonQueueMap>::const_iterator it = m_DungeonQueues.begin(); it != m_DungeonQueues.end(); ++it)
+        RemoveFromDungeonQueues(guid, it->first);
 
     for (LfgGuidListMap::iterator it = m_newToQueue.begin(); it != m_newToQueue.end(); ++it)
         it->second.remove(guid);
 
-    RemoveFromCompatibles(guid);
-
     LfgQueueInfoMap::iterator it = m_QueueInfoMap.find(guid);
     if (it != m_QueueInfoMap.end())
     {
@@ -465,6 +450,68 @@ bool LFGMgr::RemoveFromQueue(const uint64& guid)
 
 }
 
+/**
+   Adds a queued player or group to the dungeon queues of all its selected
+   dungeons, where the matchmaker looks for it
+
+   @param[in]     guid Player or group guid
+   @param[in]     queueId Queue Id the guid is queued in
+*/
+void LFGMgr::AddToDungeonQueues(uint64 guid, uint8 queueId)
+{
+    LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(guid);
+    if (itQueue == m_QueueInfoMap.end() || itQueue->second->roles.empty())
+        return;
+
+    const LfgQueueInfo* queue = itQueue->second;
+    uint8 roles = queue->roles.begin()->second;
+    LfgDungeonQueueMap& dungeonQueues = m_DungeonQueues[queueId];
+    for (LfgDungeonSet::const_iterator it = queue->dungeons.begin(); it != queue->dungeons.end(); ++it)
+    {
+        LfgDungeonQueue& dungeonQueue = dungeonQueues[*it];
+        if (queue->roles.size() > 1)
+            dungeonQueue.groups.push_back(guid);
+        else
+        {
+            if (roles & ROLE_TANK)
+                dungeonQueue.tanks.push_back(guid);
+            if (roles & ROLE_HEALER)
+                dungeonQueue.healers.push_back(guid);
+            if (roles & ROLE_DAMAGE)
+                dungeonQueue.dps.push_back(guid);
+        }
+    }
+}
+
+/**
+   Removes a player or group from the dungeon queues of all its selected dungeons
+
+   @param[in]     guid Player or group guid
+   @param[in]     queueId Queue Id the guid is queued in
+*/
+void LFGMgr::RemoveFromDungeonQueues(uint64 guid, uint8 queueId)
+{
+    LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(guid);
+    if (itQueue == m_QueueInfoMap.end())
+        return;
+
+    LfgDungeonQueueMap& dungeonQueues = m_DungeonQueues[queueId];
+    for (LfgDungeonSet::const_iterator it = itQueue->second->dungeons.begin(); it != itQueue->second->dungeons.end(); ++it)
+    {
+        LfgDungeonQueueMap::iterator itDungeonQueue = dungeonQueues.find(*it);
+        if (itDungeonQueue == dungeonQueues.end())
+            continue;
+
+        LfgDungeonQueue& dungeonQueue = itDungeonQueue->second;
+        dungeonQueue.tanks.remove(guid);
+        dungeonQueue.healers.remove(guid);
+        dungeonQueue.dps.remove(guid);
+        dungeonQueue.groups.remove(guid);
+        if (dungeonQueue.tanks.empty() && dungeonQueue.healers.empty() && dungeonQueue.dps.empty() && dungeonQueue.groups.empty())
+            dungeonQueues.erase(itDungeonQueue);
+    }
+}
+
 /**
     Generate the dungeon lock map for a given player
 
@@ -807,6 +854,33 @@ uint32 LFGMgr::GetRoleCountInDungeonQueue(uint32 dungeonId, uint8 role, uint32 t
     return count;
 }
 
+/**
+   Counts the roles queued for every dungeon, by team, in a single pass over the queue
+
+   @param[out]    counts Role counts by MAKE_PAIR64(dungeonId, team)
+*/
+void LFGMgr::GetRoleCountsInDungeonQueues(LfgRoleCountMap& counts)
+{
+    counts.clear();
+    for (LfgQueueInfoMap::const_iterator itr = m_QueueInfoMap.begin(); itr != m_QueueInfoMap.end(); ++itr)
+    {
+        if (!itr->second)
+            continue;
+
+        Player* src = sObjectMgr->GetPlayer(itr->first);
+        if (!src)
+            continue;
+
+        for (LfgDungeonSet::const_iterator itr2 = itr->second->dungeons.begin(); itr2 != itr->second->dungeons.end(); ++itr2)
+        {
+            LfgRoleCount& count = counts[MAKE_PAIR64(*itr2, src->GetTeam())];
+            count.tanks += LFG_TANKS_NEEDED - itr->second->tanks;
+            count.healers += LFG_HEALERS_NEEDED - itr->second->healers;
+            count.dps += LFG_DPS_NEEDED - itr->second->dps;
+        }
+    }
+}
+
 /**
     Leaves Dungeon System. Player/Group is removed from queue, rolechecks, proposals
     or votekicks. Player or group needs to be not NULL and using Dungeon System
@@ -894,205 +968,332 @@ void LFGMgr::OfferContinue(Group* grp)
 }
 
 /**
-   Checks que main queue to try to form a Lfg group. Returns first match found (if any)
+   Tries to form a Lfg group with the given queued player or group and the ones
+   already waiting in the same queue. For every dungeon it selected the tank,
+   healer and dps slots are filled from the players queued for that dungeon,
+   oldest first, optionally together with queued groups.
 
-   @param[in]     check List of guids trying to match with other groups
-   @param[in]     all List of all other guids in main queue to match against
+   @param[in]     guid Player or group guid being added to the queue
+   @param[in]     queueId Queue to search in
    @return Pointer to proposal, if match is found
 */
-LfgProposal* LFGMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
+LfgProposal* LFGMgr::FindNewGroup(uint64 guid, uint8 queueId)
 {
-    sLog->outDebug("LFGMgr::FindNewGroup: (%s) - all(%s)", ConcatenateGuids(check).c_str(), ConcatenateGuids(all).c_str());
-
-    LfgProposal* pProposal = NULL;
-    if (!check.size() || check.size() > MAXGROUPSIZE || !CheckCompatibility(check, pProposal))
+    LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(guid);
+    if (itQueue == m_QueueInfoMap.end())
+    {
+        sLog->outError("LFGMgr::FindNewGroup: [" UI64FMTD "] is not queued but listed as queued!", guid);
         return NULL;
+    }
+
+    LfgDungeonQueueMap& dungeonQueues = m_DungeonQueues[queueId];
+    const LfgDungeonSet& dungeons = itQueue->second->dungeons;
+    for (LfgDungeonSet::const_iterator itDungeon = dungeons.begin(); itDungeon != dungeons.end(); ++itDungeon)
+    {
+        LfgMatch match(*itDungeon);
+        if (!AddToMatch(match, guid))
+            continue;
+
+        if (match.numPlayers == MAXGROUPSIZE)
+            return CreateProposal(match);
+
+        LfgDungeonQueueMap::const_iterator itDungeonQueue = dungeonQueues.find(*itDungeon);
+        if (itDungeonQueue == dungeonQueues.end())
+            continue;
+
+        const LfgDungeonQueue& dungeonQueue = itDungeonQueue->second;
+
+        // Queued groups that can still fit next to the new entry, with the roles they take for sure
+        std::vector<LfgMatchCandidate> groups;
+        for (LfgGuidList::const_iterator itGroup = dungeonQueue.groups.begin(); itGroup != dungeonQueue.groups.end(); ++itGroup)
+        {
+            LfgQueueInfoMap::const_iterator itGroupQueue = m_QueueInfoMap.find(*itGroup);
+            if (itGroupQueue == m_QueueInfoMap.end() || match.numPlayers + itGroupQueue->second->roles.size() > MAXGROUPSIZE)
+                continue;
+
+            LfgMatchCandidate candidate(*itGroup, uint8(itGroupQueue->second->roles.size()));
+            GetFixedRoles(itGroupQueue->second->roles, candidate.fixedRoles);
+            groups.push_back(candidate);
+        }
+
+        if (FillMatchWithGroups(match, dungeonQueue, groups, 0))
+            return CreateProposal(match);
+    }
+    return NULL;
+}
+
+/**
+   Completes a match with queued players, trying first only single players and
+   then adding queued groups, oldest first. Every group takes at least two
+   slots and must fit in the roles still free, so at most two groups are
+   combined with the new entry. Groups whose size or fixed roles do not fit
+   in the free slots are skipped before any player check is done.
+
+   @param[in,out] match Match to complete (left as it was if it can not be completed)
+   @param[in]     queue Players queued for the match dungeon
+   @param[in]     groups Queued groups of the match dungeon, in queue order
+   @param[in]     firstGroup First group that can still be added
+   @return true if the match has MAXGROUPSIZE players
+*/
+bool LFGMgr::FillMatchWithGroups(LfgMatch& match, const LfgDungeonQueue& queue, const std::vector<LfgMatchCandidate>& groups, uint32 firstGroup)
+{
+    uint32 numQueues = uint32(match.queues.size());
+    if (FillMatch(match, queue))
+        return true;
+    RemoveFromMatch(match, numQueues);
 
-    // Try to match with queued groups
-    while (!pProposal && all.size() > 0)
+    for (uint32 i = firstGroup; i < groups.size(); ++i)
     {
-        check.push_back(all.front());
-        all.pop_front();
-        pProposal = FindNewGroups(check, all);
-        check.pop_back();
+        const LfgMatchCandidate& group = groups[i];
+        if (match.numPlayers + group.numPlayers > MAXGROUPSIZE ||
+            match.fixedRoles.tanks + group.fixedRoles.tanks > LFG_TANKS_NEEDED ||
+            match.fixedRoles.healers + group.fixedRoles.healers > LFG_HEALERS_NEEDED ||
+            match.fixedRoles.dps + group.fixedRoles.dps > LFG_DPS_NEEDED)
+            continue;
+
+        if (!AddToMatch(match, group.guid))
+            continue;
+
+        if (FillMatchWithGroups(match, queue, groups, i + 1))
+            return true;
+        RemoveFromMatch(match, numQueues);
     }
-    return pProposal;
+    return false;
+}
+
+/**
+   Completes a match with queued players, filling the missing roles in
+   tank, healer, dps order
+
+   @param[in,out] match Match to complete
+   @param[in]     queue Players queued for the match dungeon
+   @return true if the match has MAXGROUPSIZE players
+*/
+bool LFGMgr::FillMatch(LfgMatch& match, const LfgDungeonQueue& queue)
+{
+    while (match.numPlayers < MAXGROUPSIZE)
+    {
+        if (!AddFirstToMatch(match, queue.tanks, ROLE_TANK) &&
+            !AddFirstToMatch(match, queue.healers, ROLE_HEALER) &&
+            !AddFirstToMatch(match, queue.dps, ROLE_DAMAGE))
+            return false;
+    }
+    return true;
 }
 
 /**
-   Check compatibilities between groups
+   Adds to the match the first candidate that fits, if the given role is still free
 
-   @param[in]     check List of guids to check compatibilities
-   @param[out]    pProposal Proposal found if groups are compatibles and Match
-   @return true if group are compatibles
+   @param[in,out] match Match to add the candidate to
+   @param[in]     candidates Queued players able to take the role, in queue order
+   @param[in]     role Role the candidates are wanted for
+   @return true if a candidate was added
 */
-bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
+bool LFGMgr::AddFirstToMatch(LfgMatch& match, const LfgGuidList& candidates, uint8 role)
 {
-    if (pProposal)                                         // Do not check anything if we already have a proposal
+    if (candidates.empty())
         return false;
 
-    std::string strGuids = ConcatenateGuids(check);
+    // Check with a placeholder player if the role can still be taken
+    LfgRolesMap roles = match.roles;
+    roles[0] = role;
+    if (!CheckGroupRoles(roles))
+        return false;
+
+    for (LfgGuidList::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+        if (AddToMatch(match, *it))
+            return true;
+
+    return false;
+}
+
+/**
+   Adds a queued player or group to a match if it is compatible with the
+   members already in it. The match is not modified if they are not compatible.
+
+   @param[in,out] match Match to add the guid to
+   @param[in]     guid Player or group guid to add
+   @return true if the guid was added
+*/
+bool LFGMgr::AddToMatch(LfgMatch& match, uint64 guid)
+{
+    if (std::find(match.queues.begin(), match.queues.end(), guid) != match.queues.end())
+        return false;
 
-    if (check.size() > MAXGROUPSIZE || !check.size())
+    LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(guid);
+    if (itQueue == m_QueueInfoMap.end())
     {
-        sLog->outDebug("LFGMgr::CheckCompatibility: (%s): Size wrong - Not compatibles", strGuids.c_str());
+        sLog->outError("LFGMgr::AddToMatch: [" UI64FMTD "] is not queued but listed as queued!", guid);
         return false;
     }
 
-    if (check.size() == 1 && IS_PLAYER_GUID(check.front())) // Player joining dungeon... compatible
-        return true;
+    const LfgQueueInfo* queue = itQueue->second;
+    if (queue->roles.empty() || match.numPlayers + queue->roles.size() > MAXGROUPSIZE)
+        return false;
 
-    // Previously cached?
-    LfgAnswer answer = GetCompatibles(strGuids);
-    if (answer != LFG_ANSWER_PENDING)
+    // Do not match groups already in a lfgDungeon
+    uint32 groupLowGuid = 0;
+    if (IS_GROUP(guid))
     {
-        sLog->outDebug("LFGMgr::CheckCompatibility: (%s) compatibles (cached): %d", strGuids.c_str(), answer);
-        return bool(answer);
+        uint32 lowGuid = GUID_LOPART(guid);
+        if (Group* grp = sObjectMgr->GetGroupByGUID(lowGuid))
+            if (grp->isLFGGroup())
+            {
+                if (match.groupLowGuid)
+                    return false;
+                groupLowGuid = lowGuid;
+            }
     }
 
-    // Check all but new compatiblitity
-    if (check.size() > 2)
+    // ----- Player checks -----
+    LfgRolesMap roles = match.roles;
+    PlayerSet players = match.players;
+    for (LfgRolesMap::const_iterator itRoles = queue->roles.begin(); itRoles != queue->roles.end(); ++itRoles)
     {
-        uint64 frontGuid = check.front();
-        check.pop_front();
-
-        // Check all-but-new compatibilities (New,A,B,C,D) --> check(A,B,C,D)
-        if (!CheckCompatibility(check, pProposal))          // Group not compatible
-        {
-            sLog->outDebug("LFGMgr::CheckCompatibility: (%s) not compatibles (%s not compatibles)", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, false);
+        if (roles.find(itRoles->first) != roles.end())     // Player in multiples queues!
             return false;
-        }
-        check.push_front(frontGuid);
-        // all-but-new compatibles, now check with new
-    }
 
-    uint8 numPlayers = 0;
-    uint8 numLfgGroups = 0;
-    uint32 groupLowGuid = 0;
-    LfgQueueInfoMap pqInfoMap;
-    for (LfgGuidList::const_iterator it = check.begin(); it != check.end() && numLfgGroups < 2 && numPlayers <= MAXGROUPSIZE; ++it)
-    {
-        uint64 guid = (*it);
-        LfgQueueInfoMap::iterator itQueue = m_QueueInfoMap.find(guid);
-        if (itQueue == m_QueueInfoMap.end())
+        Player* plr = sObjectMgr->GetPlayer(itRoles->first);
+        if (!plr)
         {
-            sLog->outError("LFGMgr::CheckCompatibility: [" UI64FMTD "] is not queued but listed as queued!", (*it));
-            RemoveFromQueue(guid);
+            sLog->outDebug("LFGMgr::AddToMatch: [" UI64FMTD "] Warning! [" UI64FMTD "] offline! Marking as not compatibles!", guid, itRoles->first);
             return false;
         }
-        pqInfoMap[guid] = itQueue->second;
-        numPlayers += itQueue->second->roles.size();
 
-        if (IS_GROUP(guid))
-        {
-            uint32 lowGuid = GUID_LOPART(guid);
-            if (Group* grp = sObjectMgr->GetGroupByGUID(lowGuid))
-                if (grp->isLFGGroup())
-                {
-                    if (!numLfgGroups)
-                        groupLowGuid = lowGuid;
-                    ++numLfgGroups;
-                }
-        }
-    }
+        // Do not form a group with ignoring candidates
+        for (PlayerSet::const_iterator itPlayer = players.begin(); itPlayer != players.end(); ++itPlayer)
+            if (plr->GetSocial()->HasIgnore((*itPlayer)->GetGUIDLow()) || (*itPlayer)->GetSocial()->HasIgnore(plr->GetGUIDLow()))
+            {
+                sLog->outDebug("LFGMgr::AddToMatch: Players [" UI64FMTD "] and [" UI64FMTD "] ignoring", (*itPlayer)->GetGUID(), plr->GetGUID());
+                return false;
+            }
 
-    if (check.size() == 1 && numPlayers != MAXGROUPSIZE)   // Single group with less than MAXGROUPSIZE - Compatibles
-        return true;
+        // Dungeon locked for this player
+        const LfgLockMap& lockMap = GetLockedDungeons(itRoles->first);
+        for (LfgLockMap::const_iterator itLock = lockMap.begin(); itLock != lockMap.end(); ++itLock)
+            if ((itLock->first & 0x00FFFFFF) == match.dungeonId)
+                return false;
 
-    // Do not match - groups already in a lfgDungeon or too much players
-    if (numLfgGroups > 1 || numPlayers > MAXGROUPSIZE)
-    {
-        SetCompatibles(strGuids, false);
-        if (numLfgGroups > 1)
-            sLog->outDebug("LFGMgr::CheckCompatibility: (%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
-        else
-            sLog->outDebug("LFGMgr::CheckCompatibility: (%s) Too much players (%u)", strGuids.c_str(), numPlayers);
-        return false;
+        roles[itRoles->first] = itRoles->second;
+        players.insert(plr);
     }
 
-    // ----- Player checks -----
-    LfgRolesMap rolesMap;
-    uint64 leader = 0;
-    for (LfgQueueInfoMap::const_iterator it = pqInfoMap.begin(); it != pqInfoMap.end(); ++it)
-    {
-        for (LfgRolesMap::const_iterator itRoles = it->second->roles.begin(); itRoles != it->second->roles.end(); ++itRoles)
-        {
-            // Assign new leader
-            if (itRoles->second & ROLE_LEADER && (!leader || urand(0, 1)))
-                leader = itRoles->first;
+    LfgRolesMap checkRoles = roles;
+    if (!CheckGroupRoles(checkRoles))
+        return false;
 
-            rolesMap[itRoles->first] = itRoles->second;
-        }
-    }
+    LfgFixedRoles fixedRoles;
+    GetFixedRoles(queue->roles, fixedRoles);
+
+    match.queues.push_back(guid);
+    match.roles.swap(roles);
+    match.players.swap(players);
+    match.numPlayers = uint8(match.players.size());
+    match.fixedRoles.tanks += fixedRoles.tanks;
+    match.fixedRoles.healers += fixedRoles.healers;
+    match.fixedRoles.dps += fixedRoles.dps;
+    if (groupLowGuid)
+        match.groupLowGuid = groupLowGuid;
+    return true;
+}
 
-    if (rolesMap.size() != numPlayers)                     // Player in multiples queues!
-        return false;
+/**
+   Takes out of a match the players and groups added last, undoing AddToMatch
 
-    PlayerSet players;
-    for (LfgRolesMap::const_iterator it = rolesMap.begin(); it != rolesMap.end(); ++it)
+   @param[in,out] match Match to take them out of
+   @param[in]     numQueues Queued guids to keep in the match
+*/
+void LFGMgr::RemoveFromMatch(LfgMatch& match, uint32 numQueues)
+{
+    while (match.queues.size() > numQueues)
     {
-        Player* plr = sObjectMgr->GetPlayer(it->first);
-        if (!plr)
-            sLog->outDebug("LFGMgr::CheckCompatibility: (%s) Warning! [" UI64FMTD "] offline! Marking as not compatibles!", strGuids.c_str(), it->first);
-        else
+        uint64 guid = match.queues.back();
+        match.queues.pop_back();
+
+        if (IS_GROUP(guid) && match.groupLowGuid == GUID_LOPART(guid))
+            match.groupLowGuid = 0;
+
+        LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(guid);
+        if (itQueue == m_QueueInfoMap.end())
+            continue;
+
+        const LfgRolesMap& roles = itQueue->second->roles;
+        for (LfgRolesMap::const_iterator itRoles = roles.begin(); itRoles != roles.end(); ++itRoles)
         {
-            for (PlayerSet::const_iterator itPlayer = players.begin(); itPlayer != players.end() && plr; ++itPlayer)
-            {
-                // Do not form a group with ignoring candidates
-                if (plr->GetSocial()->HasIgnore((*itPlayer)->GetGUIDLow()) || (*itPlayer)->GetSocial()->HasIgnore(plr->GetGUIDLow()))
+            match.roles.erase(itRoles->first);
+            for (PlayerSet::iterator itPlayer = match.players.begin(); itPlayer != match.players.end(); ++itPlayer)
+                if ((*itPlayer)->GetGUID() == itRoles->first)
                 {
-                    sLog->outDebug("LFGMgr::CheckCompatibility: (%s) Players [" UI64FMTD "] and [" UI64FMTD "] ignoring", strGuids.c_str(), (*itPlayer)->GetGUID(), plr->GetGUID());
-                    plr = NULL;
+                    match.players.erase(itPlayer);
+                    break;
                 }
-            }
-            if (plr)
-                players.insert(plr);
         }
+
+        LfgFixedRoles fixedRoles;
+        GetFixedRoles(roles, fixedRoles);
+        match.fixedRoles.tanks -= fixedRoles.tanks;
+        match.fixedRoles.healers -= fixedRoles.healers;
+        match.fixedRoles.dps -= fixedRoles.dps;
     }
+    match.numPlayers = uint8(match.players.size());
+}
 
-    // if we dont have the same ammount of players then we have self ignoring candidates or different faction groups
-    // otherwise check if roles are compatible
-    if (players.size() != numPlayers || !CheckGroupRoles(rolesMap))
+/**
+   Counts the players that selected a single role
+
+   @param[in]     roles Selected roles of the players
+   @param[out]    fixedRoles Players by the only role they can take
+*/
+void LFGMgr::GetFixedRoles(const LfgRolesMap& roles, LfgFixedRoles& fixedRoles)
+{
+    for (LfgRolesMap::const_iterator it = roles.begin(); it != roles.end(); ++it)
     {
-        if (players.size() == numPlayers)
-            sLog->outDebug("LFGMgr::CheckCompatibility: (%s) Roles not compatible", strGuids.c_str());
-        SetCompatibles(strGuids, false);
-        return false;
+        switch (it->second & ~ROLE_LEADER)
+        {
+            case ROLE_TANK:
+                ++fixedRoles.tanks;
+                break;
+            case ROLE_HEALER:
+                ++fixedRoles.healers;
+                break;
+            case ROLE_DAMAGE:
+                ++fixedRoles.dps;
+                break;
+            default:
+                break;
+        }
     }
+}
 
+/**
+   Creates the proposal of a complete match
+
+   @param[in]     match Match with MAXGROUPSIZE compatible players
+   @return Pointer to the new proposal
+*/
+LfgProposal* LFGMgr::CreateProposal(const LfgMatch& match)
+{
     // ----- Selected Dungeon checks -----
-    // Check if there are any compatible dungeon from the selected dungeons
+    // The match dungeon is shared by all of them, look for the others they have in common
     LfgDungeonSet compatibleDungeons;
-
-    LfgQueueInfoMap::const_iterator itFirst = pqInfoMap.begin();
-    for (LfgDungeonSet::const_iterator itDungeon = itFirst->second->dungeons.begin(); itDungeon != itFirst->second->dungeons.end(); ++itDungeon)
+    LfgGuidList::const_iterator itFirst = match.queues.begin();
+    const LfgDungeonSet& firstDungeons = m_QueueInfoMap[*itFirst]->dungeons;
+    for (LfgDungeonSet::const_iterator itDungeon = firstDungeons.begin(); itDungeon != firstDungeons.end(); ++itDungeon)
     {
-        LfgQueueInfoMap::const_iterator itOther = itFirst;
+        LfgGuidList::const_iterator itOther = itFirst;
         ++itOther;
-        while(itOther != pqInfoMap.end() && itOther->second->dungeons.find(*itDungeon) != itOther->second->dungeons.end())
+        while (itOther != match.queues.end() && m_QueueInfoMap[*itOther]->dungeons.find(*itDungeon) != m_QueueInfoMap[*itOther]->dungeons.end())
             ++itOther;
 
-        if (itOther == pqInfoMap.end())
+        if (itOther == match.queues.end())
             compatibleDungeons.insert(*itDungeon);
     }
     LfgLockPartyMap lockMap;
-    GetCompatibleDungeons(compatibleDungeons, players, lockMap);
-
-    if (compatibleDungeons.empty())
-    {
-        SetCompatibles(strGuids, false);
-        return false;
-    }
-    SetCompatibles(strGuids, true);
+    GetCompatibleDungeons(compatibleDungeons, match.players, lockMap);
+    if (compatibleDungeons.empty())                        // Should not happen, match dungeon is not locked
+        compatibleDungeons.insert(match.dungeonId);
 
-    // ----- Group is compatible, if we have MAXGROUPSIZE members then match is found
-    if (numPlayers != MAXGROUPSIZE)
-    {
-        sLog->outDebug("LFGMgr::CheckCompatibility: (%s) Compatibles but not match. Players(%u)", strGuids.c_str(), numPlayers);
-        return true;
-    }
-    sLog->outDebug("LFGMgr::CheckCompatibility: (%s) MATCH! Group formed", strGuids.c_str());
+    sLog->outDebug("LFGMgr::CreateProposal: MATCH! Group formed (%u queued)", uint32(match.queues.size()));
 
     // GROUP FORMED!
     // TODO - Improve algorithm to select proper group based on Item Level
@@ -1105,25 +1306,34 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         ++itDungeon;
 
     // Create a new proposal
-    pProposal = new LfgProposal(*itDungeon);
+    LfgProposal* pProposal = new LfgProposal(*itDungeon);
     pProposal->cancelTime = time_t(time(NULL)) + LFG_TIME_PROPOSAL;
     pProposal->state = LFG_PROPOSAL_INITIATING;
-    pProposal->queues = check;
-    pProposal->groupLowGuid = groupLowGuid;
+    pProposal->queues = match.queues;
+    pProposal->groupLowGuid = match.groupLowGuid;
+
+    // Assign new leader
+    uint64 leader = 0;
+    for (LfgRolesMap::const_iterator itRoles = match.roles.begin(); itRoles != match.roles.end(); ++itRoles)
+        if (itRoles->second & ROLE_LEADER && (!leader || urand(0, 1)))
+            leader = itRoles->first;
 
-    // Assign new roles to players and assign new leader
-    PlayerSet::const_iterator itPlayers = players.begin();
+    PlayerSet::const_iterator itPlayers = match.players.begin();
     if (!leader)
     {
-        uint8 pos = uint8(urand(0, players.size() - 1));
+        uint8 pos = uint8(urand(0, match.players.size() - 1));
         for (uint8 i = 0; i < pos; ++i)
             ++itPlayers;
         leader = (*itPlayers)->GetGUID();
     }
     pProposal->leader = leader;
 
+    // Assign new roles to players
+    LfgRolesMap rolesMap = match.roles;
+    CheckGroupRoles(rolesMap);
+
     uint8 numAccept = 0;
-    for (itPlayers = players.begin(); itPlayers != players.end(); ++itPlayers)
+    for (itPlayers = match.players.begin(); itPlayers != match.players.end(); ++itPlayers)
     {
         uint64 guid = (*itPlayers)->GetGUID();
         LfgProposalPlayer* ppPlayer = new LfgProposalPlayer();
@@ -1142,7 +1352,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     if (numAccept == MAXGROUPSIZE)
         pProposal->state = LFG_PROPOSAL_SUCCESS;
 
-    return true;
+    return pProposal;
 }
 
 /**
@@ -1261,53 +1471,6 @@ void LFGMgr::UpdateRoleCheck(uint64& gguid, uint64 guid /* = 0 */, uint8 roles /
     }
 }
 
-/**
-   Remove from cached compatible dungeons any entry that contains the given guid
-
-   @param[in]     guid Guid to remove from compatible cache
-*/
-void LFGMgr::RemoveFromCompatibles(uint64 guid)
-{
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
-
-    sLog->outDebug("LFGMgr::RemoveFromCompatibles: Removing [" UI64FMTD "]", guid);
-    for (LfgCompatibleMap::iterator itNext = m_CompatibleMap.begin(); itNext != m_CompatibleMap.end();)
-    {
-        LfgCompatibleMap::iterator it = itNext++;
-        if (it->first.find(strGuid) != std::string::npos)  // Found, remove it
-            m_CompatibleMap.erase(it);
-    }
-}
-
-/**
-   Stores the compatibility of a list of guids
-
-   @param[in]     key String concatenation of guids (| used as separator)
-   @param[in]     compatibles Compatibles or not
-*/
-void LFGMgr::SetCompatibles(std::string key, bool compatibles)
-{
-    m_CompatibleMap[key] = LfgAnswer(compatibles);
-}
-
-/**
-   Get the compatibility of a group of guids
-
-   @param[in]     key String concatenation of guids (| used as separator)
-   @return 1 (Compatibles), 0 (Not compatibles), -1 (Not set)
-*/
-LfgAnswer LFGMgr::GetCompatibles(std::string key)
-{
-    LfgAnswer answer = LFG_ANSWER_PENDING;
-    LfgCompatibleMap::iterator it = m_CompatibleMap.find(key);
-    if (it != m_CompatibleMap.end())
-        answer = it->second;
-
-    return answer;
-}
-
 /**
    Given a list of dungeons remove the dungeons players have restrictions.
 
@@ -2064,26 +2227,6 @@ uint32 LFGMgr::GetDungeonIdForAchievement(uint32 achievementId)
     return 0;
 };
 
-/**
-   Given a list of guids returns the concatenation using | as delimiter
-
-   @param[in]     check list of guids
-   @returns Concatenated string
-*/
-std::string LFGMgr::ConcatenateGuids(LfgGuidList check)
-{
-    if (check.empty())
-        return "";
-
-    std::ostringstream o;
-    LfgGuidList::const_iterator it = check.begin();
-    o << (*it);
-    for (++it; it != check.end(); ++it)
-        o << "|" << (*it);
-    return o.str();
-}
-
-
 LfgState LFGMgr::GetState(const uint64& guid)
 {
     sLog->outDebug("LFGMgr::GetState: [" UI64FMTD "]", guid);
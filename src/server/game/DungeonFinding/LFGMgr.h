@@ -129,6 +129,8 @@ struct LfgRoleCheck;
 struct LfgProposal;
 struct LfgProposalPlayer;
 struct LfgPlayerBoot;
+struct LfgDungeonQueue;
+struct LfgRoleCount;
 
 typedef std::set<uint64> LfgGuidSet;
 typedef std::list<uint64> LfgGuidList;
@@ -137,7 +139,6 @@ typedef std::set<Player*> PlayerSet;
 typedef std::list<Player*> LfgPlayerList;
 typedef std::multimap<uint32, LfgReward const*> LfgRewardMap;
 typedef std::pair<LfgRewardMap::const_iterator, LfgRewardMap::const_iterator> LfgRewardMapBounds;
-typedef std::map<std::string, LfgAnswer> LfgCompatibleMap;
 typedef std::map<uint64, LfgDungeonSet> LfgDungeonMap;
 typedef std::map<uint64, uint8> LfgRolesMap;
 typedef std::map<uint64, LfgAnswer> LfgAnswerMap;
@@ -149,6 +150,8 @@ typedef std::map<uint32, LfgPlayerBoot*> LfgPlayerBootMap;
 typedef std::map<uint64, LfgGroupData> LfgGroupDataMap;
 typedef std::map<uint64, LfgPlayerData> LfgPlayerDataMap;
 typedef std::map<uint32, Position> LfgEntrancePositionMap;
+typedef std::map<uint32, LfgDungeonQueue> LfgDungeonQueueMap;
+typedef std::map<uint64, LfgRoleCount> LfgRoleCountMap;
 
 // Data needed by SMSG_LFG_JOIN_RESULT
 struct LfgJoinResultData
@@ -207,6 +210,55 @@ struct LfgQueueInfo
     LfgRolesMap roles;                                     ///< Selected Player Role/s
 };
 
+/// Queued players and groups that selected a dungeon, in queue order
+struct LfgDungeonQueue
+{
+    LfgGuidList tanks;                                     ///< Players able to tank
+    LfgGuidList healers;                                   ///< Players able to heal
+    LfgGuidList dps;                                       ///< Players able to deal damage
+    LfgGuidList groups;                                    ///< Groups with more than one player
+};
+
+/// Roles that can only be taken by the given player or group members
+struct LfgFixedRoles
+{
+    LfgFixedRoles(): tanks(0), healers(0), dps(0) {};
+    uint8 tanks;                                           ///< Members only able to tank
+    uint8 healers;                                         ///< Members only able to heal
+    uint8 dps;                                             ///< Members only able to deal damage
+};
+
+/// Queued group the matchmaker may add to a match
+struct LfgMatchCandidate
+{
+    LfgMatchCandidate(uint64 _guid, uint8 _numPlayers): guid(_guid), numPlayers(_numPlayers) {};
+    uint64 guid;                                           ///< Group guid
+    uint8 numPlayers;                                      ///< Group members
+    LfgFixedRoles fixedRoles;                              ///< Roles the members take whatever the match
+};
+
+/// Players and groups being put together by the matchmaker
+struct LfgMatch
+{
+    LfgMatch(uint32 dungeon): dungeonId(dungeon), numPlayers(0), groupLowGuid(0) {};
+    uint32 dungeonId;                                      ///< Dungeon all of them selected
+    uint8 numPlayers;                                      ///< Players in the match
+    LfgFixedRoles fixedRoles;                              ///< Roles already taken for sure by the players in the match
+    uint32 groupLowGuid;                                   ///< Lfg group in the match (0 if none)
+    LfgGuidList queues;                                    ///< Queued guids in the match
+    LfgRolesMap roles;                                     ///< Selected roles of the players
+    PlayerSet players;                                     ///< Players in the match
+};
+
+/// Roles covered by the players queued for a dungeon
+struct LfgRoleCount
+{
+    LfgRoleCount(): tanks(0), healers(0), dps(0) {};
+    uint32 tanks;
+    uint32 healers;
+    uint32 dps;
+};
+
 /// Stores player data related to proposal to join
 struct LfgProposalPlayer
 {
@@ -323,23 +375,28 @@ class LFGMgr
         void AddToQueue(const uint64& guid, uint8 queueId);
         bool RemoveFromQueue(const uint64& guid);
         uint32 GetRoleCountInDungeonQueue(uint32 dungeonId, uint8 role, uint32 team);
+        void GetRoleCountsInDungeonQueues(LfgRoleCountMap& counts);
+        void AddToDungeonQueues(uint64 guid, uint8 queueId);
+        void RemoveFromDungeonQueues(uint64 guid, uint8 queueId);
 
         // Proposals
         void RemoveProposal(LfgProposalMap::iterator itProposal, LfgUpdateType type);
 
         // Group Matching
-        LfgProposal* FindNewGroups(LfgGuidList& check, LfgGuidList& all);
+        LfgProposal* FindNewGroup(uint64 guid, uint8 queueId);
+        bool FillMatch(LfgMatch& match, const LfgDungeonQueue& queue);
+        bool FillMatchWithGroups(LfgMatch& match, const LfgDungeonQueue& queue, const std::vector<LfgMatchCandidate>& groups, uint32 firstGroup);
+        bool AddFirstToMatch(LfgMatch& match, const LfgGuidList& candidates, uint8 role);
+        bool AddToMatch(LfgMatch& match, uint64 guid);
+        void RemoveFromMatch(LfgMatch& match, uint32 numQueues);
+        void GetFixedRoles(const LfgRolesMap& roles, LfgFixedRoles& fixedRoles);
+        LfgProposal* CreateProposal(const LfgMatch& match);
         bool CheckGroupRoles(LfgRolesMap &groles, bool removeLeaderFlag = true);
-        bool CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal);
         void GetCompatibleDungeons(LfgDungeonSet& dungeons, const PlayerSet& players, LfgLockPartyMap& lockMap);
-        void SetCompatibles(std::string concatenatedGuids, bool compatibles);
-        LfgAnswer GetCompatibles(std::string concatenatedGuids);
-        void RemoveFromCompatibles(uint64 guid);
 
         // Generic
         const LfgDungeonSet& GetDungeonsByRandom(uint32 randomdungeon);
         LfgType GetDungeonType(uint32 dungeon);
-        std::string ConcatenateGuids(LfgGuidList check);
 
         // General variables
         bool m_update;                                     ///< Doing an update?
@@ -360,9 +417,8 @@ class LFGMgr
         std::map<uint32, uint32> m_EncountersByAchievement;///< Stores dungeon ids associated with achievements (for rewards)
         // Queue
         LfgQueueInfoMap m_QueueInfoMap;                    ///< Queued groups
-        LfgGuidListMap m_currentQueue;                     ///< Ordered list. Used to find groups
+        std::map<uint8, LfgDungeonQueueMap> m_DungeonQueues;///< Queued groups by queue and dungeon. Used to find groups
         LfgGuidListMap m_newToQueue;                       ///< New groups to add to queue
-        LfgCompatibleMap m_CompatibleMap;                  ///< Compatible dungeons
         // Rolecheck - Proposal - Vote Kicks
         LfgRoleCheckMap m_RoleChecks;                      ///< Current Role checks
         LfgProposalMap m_Proposals;                        ///< Current Proposals
@@ -38,6 +38,7 @@ void CreatureGroupManager::AddCreatureToGroup(uint32 groupId, Creature *member)
     if (!map)
         return;
 
+    ACE_GUARD(ACE_Thread_Mutex, guard, map->CreatureGroupHolderLock);
     CreatureGroupHolderType::iterator itr = map->CreatureGroupHolder.find(groupId);
 
     //Add member to an existing group
@@ -68,6 +69,7 @@ void CreatureGroupManager::RemoveCreatureFromGroup(CreatureGroup *group, Creatur
             return;
 
         sLog->outDebug("Deleting group with InstanceID %u", member->GetInstanceId());
+        ACE_GUARD(ACE_Thread_Mutex, guard, map->CreatureGroupHolderLock);
         map->CreatureGroupHolder.erase(group->GetId());
         delete group;
     }
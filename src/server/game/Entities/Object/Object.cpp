@@ -87,6 +87,7 @@ Object::Object() : m_PackGUID(sizeof(uint64)+1)
 
     m_inWorld           = false;
     m_objectUpdated     = false;
+    m_objectUpdateMap   = NULL;
 
     m_PackGUID.appendPackGUID(0);
 }
@@ -120,7 +121,7 @@ Object::~Object()
     {
         sLog->outCrash("Object::~Object - guid=" UI64FMTD ", typeid=%d, entry=%u deleted but still in update list!!", GetGUID(), GetTypeId(), GetEntry());
         ASSERT(false);
-        sObjectAccessor->RemoveUpdateObject(this);
+        ClearUpdateMask(true);
     }
 
     delete [] m_uint32Values;
@@ -1082,11 +1083,32 @@ void Object::ClearUpdateMask(bool remove)
     if (m_objectUpdated)
     {
         if (remove)
-            sObjectAccessor->RemoveUpdateObject(this);
+        {
+            if (m_objectUpdateMap)
+                m_objectUpdateMap->RemoveUpdateObject(this);
+            else
+                sObjectAccessor->RemoveUpdateObject(this);
+        }
         m_objectUpdated = false;
+        m_objectUpdateMap = NULL;
     }
 }
 
+void Object::AddToObjectUpdateIfNeeded()
+{
+    if (!m_inWorld || m_objectUpdated)
+        return;
+
+    // changes are sent by the map the object lives in at the end of its update,
+    // objects without a fixed map are collected by ObjectAccessor on the world thread
+    m_objectUpdateMap = GetObjectUpdateMap();
+    if (m_objectUpdateMap)
+        m_objectUpdateMap->AddUpdateObject(this);
+    else
+        sObjectAccessor->AddUpdateObject(this);
+    m_objectUpdated = true;
+}
+
 void Object::BuildFieldsUpdate(Player *pl, UpdateDataMapType &data_map) const
 {
     UpdateDataMapType::iterator iter = data_map.find(pl);
@@ -1231,14 +1253,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
         m_int32Values[index] = value;
         _changesMask.SetBit(index);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1251,14 +1266,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
         m_uint32Values[index] = value;
         _changesMask.SetBit(index);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1280,14 +1288,7 @@ void Object::SetUInt64Value(uint16 index, const uint64 &value)
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1301,14 +1302,7 @@ bool Object::AddUInt64Value(uint16 index, const uint64 &value)
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
         return true;
     }
     return false;
@@ -1324,14 +1318,7 @@ bool Object::RemoveUInt64Value(uint16 index, const uint64 &value)
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
         return true;
     }
     return false;
@@ -1349,14 +1336,7 @@ void Object::SetFloatValue(uint16 index, float value)
         m_floatValues[index] = value;
         _changesMask.SetBit(index);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1376,14 +1356,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 8));
         _changesMask.SetBit(index);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1403,14 +1376,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 16));
         _changesMask.SetBit(index);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1473,14 +1439,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
         m_uint32Values[index] = newval;
         _changesMask.SetBit(index);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1497,14 +1456,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
         m_uint32Values[index] = newval;
         _changesMask.SetBit(index);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1523,14 +1475,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
         m_uint32Values[index] |= uint32(uint32(newFlag) << (offset * 8));
         _changesMask.SetBit(index);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1549,14 +1494,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (offset * 8));
         _changesMask.SetBit(index);
 
-        if (m_inWorld)
-        {
-            if (!m_objectUpdated)
-            {
-                sObjectAccessor->AddUpdateObject(this);
-                m_objectUpdated = true;
-            }
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -2199,14 +2137,7 @@ void WorldObject::SendPlaySound(uint32 Sound, bool OnlySelf)
 void Object::ForceValuesUpdateAtIndex(uint32 i)
 {
     _changesMask.SetBit(i);
-    if (m_inWorld)
-    {
-        if (!m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
-    }
+    AddToObjectUpdateIfNeeded();
 }
 
 namespace Trinity
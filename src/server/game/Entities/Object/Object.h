@@ -315,6 +315,7 @@ class Object
         }
 
         void ClearUpdateMask(bool remove);
+        void AddToObjectUpdateIfNeeded();
 
         bool LoadValues(const char* data);
 
@@ -323,6 +324,8 @@ class Object
         virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
         virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         virtual void BuildUpdate(UpdateDataMapType&) {}
+        // map whose update queue collects this object's changes, NULL means the global ObjectAccessor queue
+        virtual Map* GetObjectUpdateMap() const { return NULL; }
         void BuildFieldsUpdate(Player *, UpdateDataMapType &) const;
 
         void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
@@ -387,6 +390,7 @@ class Object
         uint16 _fieldNotifyFlags;
 
         bool m_objectUpdated;
+        Map* m_objectUpdateMap;                             // update queue the object is currently in (valid while m_objectUpdated)
 
     private:
         bool m_inWorld;
@@ -872,6 +876,7 @@ class WorldObject : public Object, public WorldLocation
         virtual void ResetMap();
         Map * GetMap() const { if(!m_currMap){return NULL;} return m_currMap; }
         Map * FindMap() const { return m_currMap; }
+        Map* GetObjectUpdateMap() const { return m_currMap; }
         //used to check all object's GetMap() calls when object is not in world!
 
         //this function should be removed in nearest time...
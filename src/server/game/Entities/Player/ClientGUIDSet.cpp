@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://www.getmangos.com/>
+ *
+ * Copyright (C) 2008-2011 Trinity <http://www.trinitycore.org/>
+ *
+ * Copyright (C) 2010-2011 Project SkyFire <http://www.projectskyfire.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "gamePCH.h"
+#include "ClientGUIDSet.h"
+
+#define CLIENT_GUID_SET_MIN_CAPACITY 64
+
+static inline size_t HashClientGUID(uint64 guid, size_t mask)
+{
+    // the low bits of a guid are a counter, high and low part are both needed to spread them
+    guid *= UI64LIT(0x9E3779B97F4A7C15);
+    return size_t(guid ^ (guid >> 32)) & mask;
+}
+
+size_t ClientGUIDSet::GetSlot(uint64 guid) const
+{
+    size_t mask = m_slots.size() - 1;
+    size_t i = HashClientGUID(guid, mask);
+    while (m_slots[i].guid && m_slots[i].guid != guid)
+        i = (i + 1) & mask;
+
+    return i;
+}
+
+bool ClientGUIDSet::contains(uint64 guid) const
+{
+    if (!m_size || !guid)
+        return false;
+
+    return m_slots[GetSlot(guid)].guid == guid;
+}
+
+bool ClientGUIDSet::insert(uint64 guid)
+{
+    if (!guid)
+        return false;
+
+    if ((m_size + 1) * 2 > m_slots.size())
+        Rehash(std::max<size_t>(m_slots.size() * 2, CLIENT_GUID_SET_MIN_CAPACITY));
+
+    Slot& slot = m_slots[GetSlot(guid)];
+    if (slot.guid == guid)
+        return false;
+
+    slot.guid = guid;
+    slot.mark = m_mark;
+    ++m_size;
+    return true;
+}
+
+bool ClientGUIDSet::erase(uint64 guid)
+{
+    if (!contains(guid))
+        return false;
+
+    // shift the following entries of the probe run back, no tombstones are left behind
+    size_t mask = m_slots.size() - 1;
+    size_t hole = GetSlot(guid);
+    for (size_t i = (hole + 1) & mask; m_slots[i].guid; i = (i + 1) & mask)
+    {
+        size_t home = HashClientGUID(m_slots[i].guid, mask);
+
+        // the entry may move into the hole only if its home slot is not between the hole and itself
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            m_slots[hole] = m_slots[i];
+            hole = i;
+        }
+    }
+
+    m_slots[hole].guid = 0;
+    --m_size;
+    return true;
+}
+
+void ClientGUIDSet::clear()
+{
+    SlotList().swap(m_slots);
+    m_size = 0;
+}
+
+void ClientGUIDSet::Mark(uint64 guid)
+{
+    if (!m_size || !guid)
+        return;
+
+    Slot& slot = m_slots[GetSlot(guid)];
+    if (slot.guid == guid)
+        slot.mark = m_mark;
+}
+
+bool ClientGUIDSet::IsUnmarked(uint64 guid) const
+{
+    if (!m_size || !guid)
+        return false;
+
+    Slot const& slot = m_slots[GetSlot(guid)];
+    return slot.guid == guid && slot.mark != m_mark;
+}
+
+void ClientGUIDSet::GetUnmarked(std::vector<uint64>& guids) const
+{
+    for (SlotList::const_iterator itr = m_slots.begin(); itr != m_slots.end(); ++itr)
+        if (itr->guid && itr->mark != m_mark)
+            guids.push_back(itr->guid);
+}
+
+void ClientGUIDSet::Rehash(size_t capacity)
+{
+    SlotList old(capacity);                                 // value initialized, all slots empty
+    old.swap(m_slots);
+
+    size_t mask = capacity - 1;
+    for (SlotList::const_iterator itr = old.begin(); itr != old.end(); ++itr)
+    {
+        if (!itr->guid)
+            continue;
+
+        size_t i = HashClientGUID(itr->guid, mask);
+        while (m_slots[i].guid)
+            i = (i + 1) & mask;
+
+        m_slots[i] = *itr;
+    }
+}
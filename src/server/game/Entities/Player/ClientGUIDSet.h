@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://www.getmangos.com/>
+ *
+ * Copyright (C) 2008-2011 Trinity <http://www.trinitycore.org/>
+ *
+ * Copyright (C) 2010-2011 Project SkyFire <http://www.projectskyfire.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef TRINITY_CLIENTGUIDSET_H
+#define TRINITY_CLIENTGUIDSET_H
+
+#include "Common.h"
+
+/// GUIDs of the objects a player's client has created, an open addressing hash set.
+/// A visibility update marks every GUID it finds in range, the ones left unmarked at its end
+/// have gone out of range - no copy of the set is needed to find them.
+class ClientGUIDSet
+{
+    struct Slot
+    {
+        uint64 guid;                                        // 0 for an empty slot
+        uint32 mark;                                        // pass which last marked the guid
+    };
+
+    typedef std::vector<Slot> SlotList;
+
+    public:
+        class const_iterator
+        {
+            friend class ClientGUIDSet;
+
+            public:
+                uint64 operator*() const { return m_itr->guid; }
+                const_iterator& operator++() { ++m_itr; SkipEmpty(); return *this; }
+                bool operator==(const_iterator const& right) const { return m_itr == right.m_itr; }
+                bool operator!=(const_iterator const& right) const { return m_itr != right.m_itr; }
+
+            private:
+                const_iterator(SlotList::const_iterator itr, SlotList::const_iterator end) : m_itr(itr), m_end(end) { SkipEmpty(); }
+                void SkipEmpty() { while (m_itr != m_end && !m_itr->guid) ++m_itr; }
+
+                SlotList::const_iterator m_itr;
+                SlotList::const_iterator m_end;
+        };
+
+        typedef const_iterator iterator;
+
+        ClientGUIDSet() : m_size(0), m_mark(0) {}
+
+        bool empty() const { return !m_size; }
+        size_t size() const { return m_size; }
+        bool contains(uint64 guid) const;
+
+        // returns false if the guid was already there, a new guid counts as marked by the current pass
+        bool insert(uint64 guid);
+        bool erase(uint64 guid);
+        void clear();
+
+        // iterators are invalidated by insert() and erase()
+        const_iterator begin() const { return const_iterator(m_slots.begin(), m_slots.end()); }
+        const_iterator end() const { return const_iterator(m_slots.end(), m_slots.end()); }
+
+        /// Visibility passes, not nested: StartPass(), Mark() every object in range, then GetUnmarked()
+        void StartPass() { ++m_mark; }
+        void Mark(uint64 guid);
+        bool IsUnmarked(uint64 guid) const;                 // in the set, but not marked by the current pass
+        void GetUnmarked(std::vector<uint64>& guids) const;
+
+    private:
+        size_t GetSlot(uint64 guid) const;                  // slot of the guid, or the empty one where it would be
+        void Rehash(size_t capacity);
+
+        SlotList m_slots;                                   // power of two sized, at most half full
+        size_t m_size;
+        uint32 m_mark;
+};
+
+#endif
@@ -133,6 +133,8 @@ enum CharacterCustomizeFlags
 #define DEATH_EXPIRE_STEP (5*MINUTE)
 #define MAX_DEATH_COUNT 3
 
+#define VOID_STORAGE_SLOT_UNSAVED UI64LIT(0xFFFFFFFFFFFFFFFF)
+
 static uint32 copseReclaimDelay[MAX_DEATH_COUNT] = { 30, 60, 120 };
 
 // == PlayerTaxi ================================================
@@ -698,10 +700,17 @@ Player::Player (WorldSession *session): Unit(), m_antiHackServant(this), m_achie
 
     m_ConditionErrorMsgId = 0;
     memset(_CUFProfiles, 0, MAX_CUF_PROFILES * sizeof(CUFProfile*));
+    _CUFProfilesChanged = (1 << MAX_CUF_PROFILES) - 1;       // first save also clears the unused slots
 
     showInstanceBindQuery=false;
 
     memset(_voidStorageItems, 0, VOID_STORAGE_MAX_SLOT * sizeof(VoidStorageItem*));
+    for (uint8 i = 0; i < VOID_STORAGE_MAX_SLOT; ++i)
+        _voidStorageSavedIds[i] = VOID_STORAGE_SLOT_UNSAVED;
+
+    m_aurasSaved = false;
+    m_spellCooldownsSaved = false;
+    m_saveFailedTransactions = TransactionTask::GetFailedCount();
 }
 
 Player::~Player ()
@@ -4512,41 +4521,67 @@ void Player::_LoadSpellCooldowns(PreparedQueryResult result)
 
 void Player::_SaveSpellCooldowns(SQLTransaction& trans)
 {
+    uint32 infTime = infinityCooldownDelayCheck;
+
+    // remove outdated and collect active
+    SpellCooldowns cooldowns;
+    for (SpellCooldowns::iterator itr = m_spellCooldowns.begin(); itr != m_spellCooldowns.end();)
+    {
+        if (itr->second.end <= m_LogonTimer)
+            m_spellCooldowns.erase(itr++);
+        else
+        {
+            if (itr->second.end <= infTime)                 // not save locked cooldowns, it will be reset or set at reload
+                cooldowns[itr->first] = itr->second;
+            ++itr;
+        }
+    }
+
+    // saved cooldowns which have expired since are skipped at load, they need no rewrite
+    bool changed = !m_spellCooldownsSaved;
+    for (SpellCooldowns::const_iterator itr = cooldowns.begin(); itr != cooldowns.end() && !changed; ++itr)
+    {
+        SpellCooldowns::const_iterator saved = m_savedSpellCooldowns.find(itr->first);
+        changed = saved == m_savedSpellCooldowns.end() || saved->second.end != itr->second.end || saved->second.itemid != itr->second.itemid;
+    }
+    for (SpellCooldowns::const_iterator itr = m_savedSpellCooldowns.begin(); itr != m_savedSpellCooldowns.end() && !changed; ++itr)
+        changed = itr->second.end > m_LogonTimer && cooldowns.find(itr->first) == cooldowns.end();
+
+    if (!changed)
+    {
+        sPlayerSaveStats->AddSection(PLAYER_SAVE_SPELL_COOLDOWNS, 0, cooldowns.empty() ? 1 : 2);
+        return;
+    }
+
     trans->PAppend("DELETE FROM character_spell_cooldown WHERE guid = '%u'", GetGUIDLow());
 
     time_t curTime = time(NULL);
-    uint32 infTime = infinityCooldownDelayCheck;
 
     bool first_round = true;
     std::ostringstream ss;
 
-    // remove outdated and save active
-    for (SpellCooldowns::iterator itr = m_spellCooldowns.begin(); itr != m_spellCooldowns.end();)
+    for (SpellCooldowns::const_iterator itr = cooldowns.begin(); itr != cooldowns.end(); ++itr)
     {
-        if (itr->second.end <= m_LogonTimer)
-            m_spellCooldowns.erase(itr++);
-        else if (itr->second.end <= infTime)                 // not save locked cooldowns, it will be reset or set at reload
-        {
-            time_t cooldownEnd = curTime + 1 + (itr->second.end - m_LogonTimer) / IN_MILLISECONDS;
+        time_t cooldownEnd = curTime + 1 + (itr->second.end - m_LogonTimer) / IN_MILLISECONDS;
 
-            if (first_round)
-            {
-                ss << "INSERT INTO character_spell_cooldown (guid,spell,item,time) VALUES ";
-                first_round = false;
-            }
-            // next new/changed record prefix
-            else
-                ss << ", ";
-            ss << "(" << GetGUIDLow() << "," << itr->first << "," << itr->second.itemid << "," << uint64(cooldownEnd) << ")";
-            ++itr;
+        if (first_round)
+        {
+            ss << "INSERT INTO character_spell_cooldown (guid,spell,item,time) VALUES ";
+            first_round = false;
         }
+        // next new/changed record prefix
         else
-            ++itr;
-
+            ss << ", ";
+        ss << "(" << GetGUIDLow() << "," << itr->first << "," << itr->second.itemid << "," << uint64(cooldownEnd) << ")";
     }
     // if something changed execute
     if (!first_round)
         trans->Append(ss.str().c_str());
+
+    sPlayerSaveStats->AddSection(PLAYER_SAVE_SPELL_COOLDOWNS, first_round ? 1 : 2, first_round ? 1 : 2);
+
+    m_savedSpellCooldowns.swap(cooldowns);
+    m_spellCooldownsSaved = true;
 }
 
 uint64 Player::ResetTalentsCost() const
@@ -16697,7 +16732,7 @@ bool Player::SatisfyQuestStatus(Quest const* qInfo, bool msg)
 
 bool Player::SatisfyQuestConditions(Quest const* qInfo, bool msg)
 {
-    ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_ACCEPT, qInfo->GetQuestId());
+    ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_ACCEPT, qInfo->GetQuestId());
     if (!sConditionMgr->IsPlayerMeetToConditions(this, conditions))
     {
         if (msg)
@@ -20509,7 +20544,7 @@ bool Player::CreateInDB()
         _SaveMail(trans);
 
     _SaveBGData(trans);
-    _SaveRatedBGData();
+    _SaveRatedBGData(trans);
     _SaveInventory(trans);
     _SaveVoidStorage(trans);
     _SaveQuestStatus(trans);
@@ -20527,8 +20562,8 @@ bool Player::CreateInDB()
     _SaveEquipmentSets(trans);
     GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
     _SaveGlyphs(trans);
-    _SaveCurrency();
-    _SaveCurrencyWeekcap();
+    _SaveCurrency(trans);
+    _SaveCurrencyWeekcap(trans);
     _SaveArchaeologyData();
 
     // check if stats should only be saved on logout
@@ -20545,6 +20580,13 @@ bool Player::CreateInDB()
     return true;
 }
 
+// empty transactions are not queued, the statements are counted for the save statistics
+static void CommitSaveTransaction(SQLTransaction& trans, uint32& statements)
+{
+    statements += uint32(trans->GetSize());
+    CharacterDatabase.CommitTransaction(trans);
+}
+
 void Player::SaveToDB()
 {
     // delay auto save at any saves (manual, in code, or autosave)
@@ -20699,11 +20741,21 @@ void Player::SaveToDB()
 
     ss << " WHERE guid = " << GetGUIDLow() << ";";
 
+    // What the previous saves wrote is only a guess of the database contents: their transactions may have
+    // been aborted since. After any failed transaction, and on logout, every section is written again.
+    uint32 failedTransactions = TransactionTask::GetFailedCount();
+    if (m_session->isLogingOut() || failedTransactions != m_saveFailedTransactions)
+    {
+        _ResetSavedRows();
+        m_saveFailedTransactions = failedTransactions;
+    }
+
+    uint32 statements = 0;
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
     trans->Append(ss.str().c_str());
 
-    CharacterDatabase.CommitTransaction(trans);
+    CommitSaveTransaction(trans, statements);
 
     trans = CharacterDatabase.BeginTransaction();
 
@@ -20712,10 +20764,10 @@ void Player::SaveToDB()
     _SaveEquipmentSets(trans);
     GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
     _SaveBGData(trans);
-    _SaveRatedBGData();
+    _SaveRatedBGData(trans);
     _SaveCUFProfiles(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CommitSaveTransaction(trans, statements);
 
     trans = CharacterDatabase.BeginTransaction();
 
@@ -20723,7 +20775,7 @@ void Player::SaveToDB()
     _SaveDailyQuestStatus(trans);
     _SaveWeeklyQuestStatus(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CommitSaveTransaction(trans, statements);
 
     trans = CharacterDatabase.BeginTransaction();
 
@@ -20732,7 +20784,7 @@ void Player::SaveToDB()
     _SaveTalents(trans);
     _SaveTalentBranchSpecs(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CommitSaveTransaction(trans, statements);
 
     trans = CharacterDatabase.BeginTransaction();
 
@@ -20741,26 +20793,26 @@ void Player::SaveToDB()
     _SaveAuras(trans);
     _SaveSkills(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CommitSaveTransaction(trans, statements);
 
     trans = CharacterDatabase.BeginTransaction();
 
     _SaveActions(trans);
     _SaveGlyphs(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CommitSaveTransaction(trans, statements);
 
     trans = CharacterDatabase.BeginTransaction();
 
     m_achievementMgr.SaveToDB(trans);
     m_reputationMgr.SaveToDB(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CommitSaveTransaction(trans, statements);
 
     trans = CharacterDatabase.BeginTransaction();
 
-    _SaveCurrency();
-    _SaveCurrencyWeekcap();
+    _SaveCurrency(trans);
+    _SaveCurrencyWeekcap(trans);
     _SaveArchaeologyData();
 
     // check if stats should only be saved on logout
@@ -20768,7 +20820,9 @@ void Player::SaveToDB()
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CommitSaveTransaction(trans, statements);
+
+    sPlayerSaveStats->AddSave(statements);
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
@@ -20797,6 +20851,49 @@ void Player::SaveGoldToDB(SQLTransaction& trans)
     trans->PAppend("UPDATE characters SET money = '" UI64FMTD "' WHERE guid = '%u'", GetMoney(), GetGUIDLow());
 }
 
+// formats a statement like Transaction::PAppend, to compare it with the row written by the previous save
+static std::string FormatSaveRow(char const* format, ...)
+{
+    va_list ap;
+    char row[MAX_QUERY_LEN];
+    va_start(ap, format);
+    vsnprintf(row, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    return std::string(row);
+}
+
+bool Player::_IsSavedRowChanged(SavedRows& saved, uint32 key, std::string const& row)
+{
+    SavedRows::iterator itr = saved.find(key);
+    if (itr == saved.end())
+    {
+        saved[key] = row;
+        return true;
+    }
+
+    if (itr->second == row)
+        return false;
+
+    itr->second = row;
+    return true;
+}
+
+void Player::_ResetSavedRows()
+{
+    for (uint8 i = 0; i < MAX_PLAYER_SAVE_SECTIONS; ++i)
+        m_savedRows[i].clear();
+
+    m_savedAuras.clear();
+    m_aurasSaved = false;
+    m_savedSpellCooldowns.clear();
+    m_spellCooldownsSaved = false;
+
+    for (uint8 i = 0; i < VOID_STORAGE_MAX_SLOT; ++i)
+        _voidStorageSavedIds[i] = VOID_STORAGE_SLOT_UNSAVED;
+    _CUFProfilesChanged = (1 << MAX_CUF_PROFILES) - 1;
+}
+
 void Player::_SaveActions(SQLTransaction& trans)
 {
     for (ActionButtonList::iterator itr = m_actionButtons.begin(); itr != m_actionButtons.end();)
@@ -20826,12 +20923,23 @@ void Player::_SaveActions(SQLTransaction& trans)
     }
 }
 
-void Player::_SaveAuras(SQLTransaction& trans)
+bool Player::SavedAura::operator==(SavedAura const& right) const
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_AURA);
-    stmt->setUInt32(0, GetGUIDLow());
-    trans->Append(stmt);
+    if (casterGuid != right.casterGuid || spellId != right.spellId || effMask != right.effMask ||
+        recalculateMask != right.recalculateMask || stackAmount != right.stackAmount || charges != right.charges ||
+        maxDuration != right.maxDuration || duration != right.duration)
+        return false;
+
+    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+        if (amount[i] != right.amount[i] || baseAmount[i] != right.baseAmount[i])
+            return false;
 
+    return true;
+}
+
+void Player::_SaveAuras(SQLTransaction& trans)
+{
+    SavedAuraMap auras;
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end() ; ++itr)
     {
         if (!itr->second->CanBeSaved())
@@ -20839,46 +20947,115 @@ void Player::_SaveAuras(SQLTransaction& trans)
 
         Aura * aura = itr->second;
 
-        int32 damage[MAX_SPELL_EFFECTS];
-        int32 baseDamage[MAX_SPELL_EFFECTS];
-        uint8 effMask = 0;
-        uint8 recalculateMask = 0;
+        SavedAura row;
+        row.casterGuid = aura->GetCasterGUID();
+        row.spellId = aura->GetId();
+        row.effMask = 0;
+        row.recalculateMask = 0;
+        row.stackAmount = aura->GetStackAmount();
+        row.charges = aura->GetCharges();
+        row.maxDuration = aura->GetMaxDuration();
+        row.duration = aura->GetDuration();
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
             if (AuraEffect const* effect = aura->GetEffect(i))
             {
-                baseDamage[i] = effect->GetBaseAmount();
-                damage[i] = effect->GetAmount();
-                effMask |= 1 << i;
+                row.baseAmount[i] = effect->GetBaseAmount();
+                row.amount[i] = effect->GetAmount();
+                row.effMask |= 1 << i;
                 if (effect->CanBeRecalculated())
-                    recalculateMask |= 1 << i;
+                    row.recalculateMask |= 1 << i;
             }
             else
             {
-                baseDamage[i] = 0;
-                damage[i] = 0;
+                row.baseAmount[i] = 0;
+                row.amount[i] = 0;
             }
         }
 
+        auras[std::make_pair(row.casterGuid, MAKE_PAIR64(row.spellId, row.effMask))] = row;
+    }
+
+    // a changed aura is deleted and inserted again, when most of them changed rewriting all is cheaper
+    uint32 rewriteCost = 1 + uint32(auras.size());
+    uint32 changed = 0;
+    uint32 removed = 0;
+    if (m_aurasSaved)
+    {
+        for (SavedAuraMap::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+        {
+            SavedAuraMap::const_iterator saved = m_savedAuras.find(itr->first);
+            if (saved == m_savedAuras.end() || saved->second != itr->second)
+                ++changed;
+        }
+        for (SavedAuraMap::const_iterator itr = m_savedAuras.begin(); itr != m_savedAuras.end(); ++itr)
+            if (auras.find(itr->first) == auras.end())
+                ++removed;
+    }
+
+    bool rewrite = !m_aurasSaved || 2 * changed + removed >= rewriteCost;
+    uint32 written = 0;
+    PreparedStatement* stmt = NULL;
+    if (rewrite)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_AURA);
+        stmt->setUInt32(0, GetGUIDLow());
+        trans->Append(stmt);
+        ++written;
+    }
+    else
+    {
+        for (SavedAuraMap::const_iterator itr = m_savedAuras.begin(); itr != m_savedAuras.end(); ++itr)
+        {
+            SavedAuraMap::const_iterator current = auras.find(itr->first);
+            if (current != auras.end() && current->second == itr->second)
+                continue;
+
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_AURA_BY_SPELL);
+            stmt->setUInt32(0, GetGUIDLow());
+            stmt->setUInt64(1, itr->second.casterGuid);
+            stmt->setUInt32(2, itr->second.spellId);
+            stmt->setUInt8(3, itr->second.effMask);
+            trans->Append(stmt);
+            ++written;
+        }
+    }
+
+    for (SavedAuraMap::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+    {
+        SavedAura const& row = itr->second;
+        if (!rewrite)
+        {
+            SavedAuraMap::const_iterator saved = m_savedAuras.find(itr->first);
+            if (saved != m_savedAuras.end() && saved->second == row)
+                continue;
+        }
+
         uint8 index = 0;
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_AURA);
         stmt->setUInt32(index++, GetGUIDLow());
-        stmt->setUInt64(index++, itr->second->GetCasterGUID());
-        stmt->setUInt32(index++, itr->second->GetId());
-        stmt->setUInt8(index++, effMask);
-        stmt->setUInt8(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, damage[0]);
-        stmt->setInt32(index++, damage[1]);
-        stmt->setInt32(index++, damage[2]);
-        stmt->setInt32(index++, baseDamage[0]);
-        stmt->setInt32(index++, baseDamage[1]);
-        stmt->setInt32(index++, baseDamage[2]);
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index, itr->second->GetCharges());
+        stmt->setUInt64(index++, row.casterGuid);
+        stmt->setUInt32(index++, row.spellId);
+        stmt->setUInt8(index++, row.effMask);
+        stmt->setUInt8(index++, row.recalculateMask);
+        stmt->setUInt8(index++, row.stackAmount);
+        stmt->setInt32(index++, row.amount[0]);
+        stmt->setInt32(index++, row.amount[1]);
+        stmt->setInt32(index++, row.amount[2]);
+        stmt->setInt32(index++, row.baseAmount[0]);
+        stmt->setInt32(index++, row.baseAmount[1]);
+        stmt->setInt32(index++, row.baseAmount[2]);
+        stmt->setInt32(index++, row.maxDuration);
+        stmt->setInt32(index++, row.duration);
+        stmt->setUInt8(index, row.charges);
         trans->Append(stmt);
+        ++written;
     }
+
+    sPlayerSaveStats->AddSection(PLAYER_SAVE_AURAS, written, rewriteCost);
+
+    m_savedAuras.swap(auras);
+    m_aurasSaved = true;
 }
 
 void Player::_SaveInventory(SQLTransaction& trans)
@@ -20996,9 +21173,15 @@ void Player::_SaveVoidStorage(SQLTransaction& trans)
 {
     PreparedStatement* stmt = NULL;
     uint32 lowGuid = GetGUIDLow();
+    uint32 written = 0;
 
     for (uint8 i = 0; i < VOID_STORAGE_MAX_SLOT; ++i)
     {
+        // item ids are unique, the same id in the slot means the same row
+        uint64 itemId = _voidStorageItems[i] ? _voidStorageItems[i]->ItemId : 0;
+        if (_voidStorageSavedIds[i] == itemId)
+            continue;
+
         if (!_voidStorageItems[i]) // unused item
         {
             // DELETE FROM void_Storage WHERE slot = ? AND playerGuid = ?
@@ -21020,16 +21203,24 @@ void Player::_SaveVoidStorage(SQLTransaction& trans)
         }
 
         trans->Append(stmt);
+        _voidStorageSavedIds[i] = itemId;
+        ++written;
     }
+
+    sPlayerSaveStats->AddSection(PLAYER_SAVE_VOID_STORAGE, written, VOID_STORAGE_MAX_SLOT);
 }
 
 void Player::_SaveCUFProfiles(SQLTransaction& trans)
 {
     PreparedStatement* stmt = NULL;
     uint32 lowGuid = GetGUIDLow();
+    uint32 written = 0;
 
     for (uint8 i = 0; i < MAX_CUF_PROFILES; ++i)
     {
+        if (!(_CUFProfilesChanged & (1 << i)))
+            continue;
+
         if (!_CUFProfiles[i]) // unused profile
         {
             // DELETE FROM character_cuf_profiles WHERE guid = ? and id = ?
@@ -21058,7 +21249,11 @@ void Player::_SaveCUFProfiles(SQLTransaction& trans)
         }
 
         trans->Append(stmt);
+        ++written;
     }
+
+    _CUFProfilesChanged = 0;
+    sPlayerSaveStats->AddSection(PLAYER_SAVE_CUF_PROFILES, written, MAX_CUF_PROFILES);
 }
 
 void Player::_SaveMail(SQLTransaction& trans)
@@ -21249,15 +21444,15 @@ void Player::_SaveSpells(SQLTransaction& trans)
     }
 }
 
-void Player::_SaveCurrency()
+void Player::_SaveCurrency(SQLTransaction& trans)
 {
     for (PlayerCurrenciesMap::iterator itr = m_currencies.begin(); itr != m_currencies.end();)
     {
         if (itr->second.state == PLAYERCURRENCY_CHANGED)
-            CharacterDatabase.PExecute("UPDATE character_currency SET `count` = '%u', `thisseason` = '%u' WHERE guid = '%u' AND currency = '%u'",
+            trans->PAppend("UPDATE character_currency SET `count` = '%u', `thisseason` = '%u' WHERE guid = '%u' AND currency = '%u'",
             itr->second.totalCount, itr->second.seasonCount, GetGUIDLow(), itr->first);
         else if (itr->second.state == PLAYERCURRENCY_NEW)
-            CharacterDatabase.PExecute("INSERT INTO character_currency (guid,currency,`count`,`thisseason`) VALUES ('%u','%u','%u','%u')",
+            trans->PAppend("INSERT INTO character_currency (guid,currency,`count`,`thisseason`) VALUES ('%u','%u','%u','%u')",
             GetGUIDLow(), itr->first, itr->second.totalCount, itr->second.seasonCount);
 
         if (itr->second.state == PLAYERCURRENCY_REMOVED)
@@ -21270,11 +21465,14 @@ void Player::_SaveCurrency()
     }
 }
 
-void Player::_SaveCurrencyWeekcap()
+void Player::_SaveCurrencyWeekcap(SQLTransaction& trans)
 {
     uint32 guid = GetGUIDLow();
     uint32 currency_id;
     CurrencySource source;
+    uint32 written = 0;
+    uint32 rewriteCost = 0;
+    SavedRows& saved = m_savedRows[PLAYER_SAVE_CURRENCY_WEEKCAP];
 
     for (PlayerCurrenciesMap::iterator itr = m_currencies.begin(); itr != m_currencies.end(); ++itr)
     {
@@ -21290,17 +21488,27 @@ void Player::_SaveCurrencyWeekcap()
             if (source == CURRENCY_SOURCE_ALL || source >= CURRENCY_SOURCE_MAX)
                 continue;
 
-            CharacterDatabase.PExecute("REPLACE INTO character_currency_weekcap VALUES ('%u','%u','%u','%u','%u');",
+            ++rewriteCost;
+            std::string row = FormatSaveRow("REPLACE INTO character_currency_weekcap VALUES ('%u','%u','%u','%u','%u');",
                 guid, currency_id, source, csitr->second, GetCurrencyWeekCount(currency_id, source));
+            if (!_IsSavedRowChanged(saved, currency_id * CURRENCY_SOURCE_MAX + source, row))
+                continue;
+
+            trans->Append(row.c_str());
+            ++written;
         }
     }
+
+    sPlayerSaveStats->AddSection(PLAYER_SAVE_CURRENCY_WEEKCAP, written, rewriteCost);
 }
 
 void Player::_SaveArchaeologyData()
 {
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    SavedRows& saved = m_savedRows[PLAYER_SAVE_RESEARCH];
 
-    trans->PAppend("REPLACE INTO character_research_site VALUES (%u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u);",
+    // row 0 is the site row, the projects are keyed by their id which is never 0
+    std::string row = FormatSaveRow("REPLACE INTO character_research_site VALUES (%u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u);",
         GetGUIDLow(), m_researchSites.site_creature[0], m_researchSites.site_creature[1], m_researchSites.site_creature[2], m_researchSites.site_creature[3],
         m_researchSites.site_creature[4], m_researchSites.site_creature[5], m_researchSites.site_creature[6], m_researchSites.site_creature[7],
         m_researchSites.site_creature[8], m_researchSites.site_creature[9], m_researchSites.site_creature[10], m_researchSites.site_creature[11],
@@ -21309,16 +21517,19 @@ void Player::_SaveArchaeologyData()
         m_researchSites.site_dig_count[4], m_researchSites.site_dig_count[5], m_researchSites.site_dig_count[6], m_researchSites.site_dig_count[7],
         m_researchSites.site_dig_count[8], m_researchSites.site_dig_count[9], m_researchSites.site_dig_count[10], m_researchSites.site_dig_count[11],
         m_researchSites.site_dig_count[12], m_researchSites.site_dig_count[13], m_researchSites.site_dig_count[14], m_researchSites.site_dig_count[15]);
+    if (_IsSavedRowChanged(saved, 0, row))
+        trans->Append(row.c_str());
 
-    if (!m_researchProjects.empty())
+    for (std::list<ResearchProjectsElem>::const_iterator itr = m_researchProjects.begin(); itr != m_researchProjects.end(); ++itr)
     {
-        for (std::list<ResearchProjectsElem>::const_iterator itr = m_researchProjects.begin(); itr != m_researchProjects.end(); ++itr)
-        {
-            trans->PAppend("REPLACE INTO character_research_project VALUES (%u, %u, %u, " UI64FMTD ", %u);",
-                GetGUIDLow(), itr->project_id, itr->completed_count, itr->completed_date, itr->active);
-        }
+        row = FormatSaveRow("REPLACE INTO character_research_project VALUES (%u, %u, %u, " UI64FMTD ", %u);",
+            GetGUIDLow(), itr->project_id, itr->completed_count, itr->completed_date, itr->active);
+        if (_IsSavedRowChanged(saved, itr->project_id, row))
+            trans->Append(row.c_str());
     }
 
+    sPlayerSaveStats->AddSection(PLAYER_SAVE_RESEARCH, uint32(trans->GetSize()), 1 + uint32(m_researchProjects.size()));
+
     CharacterDatabase.CommitTransaction(trans);
 }
 
@@ -21330,7 +21541,6 @@ void Player::_SaveStats(SQLTransaction& trans)
     if (!sWorld->getIntConfig(CONFIG_MIN_LEVEL_STAT_SAVE) || getLevel() < sWorld->getIntConfig(CONFIG_MIN_LEVEL_STAT_SAVE))
         return;
 
-    trans->PAppend("DELETE FROM character_stats WHERE guid = '%u'", GetGUIDLow());
     std::ostringstream ss;
     ss << "INSERT INTO character_stats (guid, maxhealth, maxpower1, maxpower2, maxpower3, maxpower4, maxpower5, maxpower6, maxpower7, maxpower8, maxpower9, maxpower10, "
         "strength, agility, stamina, intellect, spirit, armor, resHoly, resFire, resNature, resFrost, resShadow, resArcane, "
@@ -21356,13 +21566,28 @@ void Player::_SaveStats(SQLTransaction& trans)
        << GetUInt32Value(PLAYER_FIELD_COMBAT_RATING_1+CR_RESILIENCE_PLAYER_DAMAGE_TAKEN) << ", "
        << uint32(GetAverageItemLevel()) << ", "
        << GetAchievementMgr().GetAchievementPoints() << ")";
+
+    if (!_IsSavedRowChanged(m_savedRows[PLAYER_SAVE_STATS], 0, ss.str()))
+    {
+        sPlayerSaveStats->AddSection(PLAYER_SAVE_STATS, 0, 2);
+        return;
+    }
+
+    trans->PAppend("DELETE FROM character_stats WHERE guid = '%u'", GetGUIDLow());
     trans->Append(ss.str().c_str());
+    sPlayerSaveStats->AddSection(PLAYER_SAVE_STATS, 2, 2);
 }
 
-void Player::_SaveRatedBGData()
+void Player::_SaveRatedBGData(SQLTransaction& trans)
 {
-    CharacterDatabase.PExecute("REPLACE INTO character_rated_bg_stats (guid, rating, matches_won, matches_lost) VALUES (%u, %u, %u, %u)", GetGUIDLow(), GetRatedBattlegroundRating(),
+    std::string row = FormatSaveRow("REPLACE INTO character_rated_bg_stats (guid, rating, matches_won, matches_lost) VALUES (%u, %u, %u, %u)", GetGUIDLow(), GetRatedBattlegroundRating(),
         GetRatedBattlegroundStat(RATED_BG_STAT_MATCHES_WON), GetRatedBattlegroundStat(RATED_BG_STAT_MATCHES_LOST));
+
+    bool changed = _IsSavedRowChanged(m_savedRows[PLAYER_SAVE_RATED_BG_DATA], 0, row);
+    if (changed)
+        trans->Append(row.c_str());
+
+    sPlayerSaveStats->AddSection(PLAYER_SAVE_RATED_BG_DATA, changed ? 1 : 0, 1);
 }
 
 void Player::outDebugValues() const
@@ -22035,7 +22260,7 @@ void Player::VehicleSpellInitialize()
         if (!spellInfo)
             continue;
 
-        ConditionList conditions = sConditionMgr->GetConditionsForVehicleSpell(veh->ToCreature()->GetEntry(), spellId);
+        ConditionList const& conditions = sConditionMgr->GetConditionsForVehicleSpell(veh->ToCreature()->GetEntry(), spellId);
         if (!sConditionMgr->IsPlayerMeetToConditions(this, conditions))
         {
             sLog->outDebug("VehicleSpellInitialize: conditions not met for Vehicle entry %u spell %u", veh->ToCreature()->GetEntry(), spellId);
@@ -24222,13 +24447,13 @@ bool Player::IsVisibleGloballyFor(Player* u) const
 }
 
 template<class T>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, T* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, T* target, std::vector<Unit*>& /*v*/)
 {
     s64.insert(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, GameObject* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, GameObject* target, std::vector<Unit*>& /*v*/)
 {
     // @HACK: This is to prevent objects like deeprun tram from disappearing when player moves far from its spawn point while riding it
     // But exclude stoppable elevators from this hack - they would be teleporting from one end to another
@@ -24239,17 +24464,17 @@ inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, GameObject* target,
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, Creature* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, Creature* target, std::vector<Unit*>& v)
 {
     s64.insert(target->GetGUID());
-    v.insert(target);
+    v.push_back(target);
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, Player* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, Player* target, std::vector<Unit*>& v)
 {
     s64.insert(target->GetGUID());
-    v.insert(target);
+    v.push_back(target);
 }
 
 template<class T>
@@ -24381,7 +24606,7 @@ void Player::SendInitialVisiblePackets(Unit* target)
 }
 
 template<class T>
-void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& visibleNow)
+void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::vector<Unit*>& visibleNow)
 {
     if (HaveAtClient(target))
     {
@@ -24417,12 +24642,12 @@ void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& vi
     }
 }
 
-template void Player::UpdateVisibilityOf(Player*        target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(Creature*      target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(Corpse*        target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(GameObject*    target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(AreaTrigger*   target, UpdateData& data, std::set<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(Player*        target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(Creature*      target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(Corpse*        target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(GameObject*    target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(AreaTrigger*   target, UpdateData& data, std::vector<Unit*>& visibleNow);
 
 void Player::UpdateObjectVisibility(bool forced)
 {
@@ -28288,14 +28513,27 @@ void Player::_SaveEquipmentSets(SQLTransaction& trans)
 
 void Player::_SaveBGData(SQLTransaction& trans)
 {
-    trans->PAppend("DELETE FROM character_battleground_data WHERE guid='%u'", GetGUIDLow());
+    // an empty row stands for no battleground data
+    std::string row;
     if (m_bgData.bgInstanceID)
     {
         /* guid, bgInstanceID, bgTeam, x, y, z, o, map, taxi[0], taxi[1], mountSpell */
-        trans->PAppend("INSERT INTO character_battleground_data VALUES ('%u', '%u', '%u', '%f', '%f', '%f', '%f', '%u', '%u', '%u', '%u')",
+        row = FormatSaveRow("INSERT INTO character_battleground_data VALUES ('%u', '%u', '%u', '%f', '%f', '%f', '%f', '%u', '%u', '%u', '%u')",
             GetGUIDLow(), m_bgData.bgInstanceID, m_bgData.bgTeam, m_bgData.joinPos.GetPositionX(), m_bgData.joinPos.GetPositionY(), m_bgData.joinPos.GetPositionZ(),
             m_bgData.joinPos.GetOrientation(), m_bgData.joinPos.GetMapId(), m_bgData.taxiPath[0], m_bgData.taxiPath[1], m_bgData.mountSpell);
     }
+
+    uint32 rewriteCost = row.empty() ? 1 : 2;
+    if (!_IsSavedRowChanged(m_savedRows[PLAYER_SAVE_BG_DATA], 0, row))
+    {
+        sPlayerSaveStats->AddSection(PLAYER_SAVE_BG_DATA, 0, rewriteCost);
+        return;
+    }
+
+    trans->PAppend("DELETE FROM character_battleground_data WHERE guid='%u'", GetGUIDLow());
+    if (!row.empty())
+        trans->Append(row.c_str());
+    sPlayerSaveStats->AddSection(PLAYER_SAVE_BG_DATA, rewriteCost, rewriteCost);
 }
 
 void Player::DeleteEquipmentSet(uint64 setGuid)
@@ -28416,22 +28654,82 @@ void Player::_LoadGlyphs(PreparedQueryResult result)
 
 void Player::_SaveGlyphs(SQLTransaction& trans)
 {
-    trans->PAppend("DELETE FROM character_glyphs WHERE guid='%u'",GetGUIDLow());
+    SavedRows& saved = m_savedRows[PLAYER_SAVE_GLYPHS];
+    uint32 written = 0;
+
+    // the first save of the session also removes the specs the character had before
+    bool rewrite = saved.empty();
+    if (rewrite)
+    {
+        trans->PAppend("DELETE FROM character_glyphs WHERE guid='%u'",GetGUIDLow());
+        ++written;
+    }
+
     for (uint8 spec = 0; spec < m_specsCount; ++spec)
     {
-        trans->PAppend("INSERT INTO character_glyphs VALUES('%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u')",
+        std::string row = FormatSaveRow("INSERT INTO character_glyphs VALUES('%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u')",
             GetGUIDLow(), spec, m_Glyphs[spec][0], m_Glyphs[spec][1], m_Glyphs[spec][2], m_Glyphs[spec][3], m_Glyphs[spec][4], m_Glyphs[spec][5], m_Glyphs[spec][6], m_Glyphs[spec][7], m_Glyphs[spec][8]);
+        if (!_IsSavedRowChanged(saved, spec, row))
+            continue;
+
+        if (!rewrite)
+        {
+            trans->PAppend("DELETE FROM character_glyphs WHERE guid='%u' AND spec='%u'", GetGUIDLow(), spec);
+            ++written;
+        }
+        trans->Append(row.c_str());
+        ++written;
+    }
+
+    // specs dropped since the last save
+    for (SavedRows::iterator itr = saved.lower_bound(m_specsCount); itr != saved.end();)
+    {
+        trans->PAppend("DELETE FROM character_glyphs WHERE guid='%u' AND spec='%u'", GetGUIDLow(), itr->first);
+        ++written;
+        saved.erase(itr++);
     }
+
+    sPlayerSaveStats->AddSection(PLAYER_SAVE_GLYPHS, written, 1 + m_specsCount);
 }
 
 void Player::_SaveTalentBranchSpecs(SQLTransaction& trans)
 {
-    trans->PAppend("DELETE FROM character_branchspec WHERE guid='%u'",GetGUIDLow());
+    SavedRows& saved = m_savedRows[PLAYER_SAVE_BRANCH_SPECS];
+    uint32 written = 0;
+
+    // the first save of the session also removes the specs the character had before
+    bool rewrite = saved.empty();
+    if (rewrite)
+    {
+        trans->PAppend("DELETE FROM character_branchspec WHERE guid='%u'",GetGUIDLow());
+        ++written;
+    }
+
     for (uint8 spec = 0; spec < m_specsCount; ++spec)
     {
-        trans->PAppend("INSERT INTO character_branchspec VALUES('%u', '%u', '%u')",
+        std::string row = FormatSaveRow("INSERT INTO character_branchspec VALUES('%u', '%u', '%u')",
                        GetGUIDLow(), spec, GetTalentBranchSpec(spec));
+        if (!_IsSavedRowChanged(saved, spec, row))
+            continue;
+
+        if (!rewrite)
+        {
+            trans->PAppend("DELETE FROM character_branchspec WHERE guid='%u' AND spec='%u'", GetGUIDLow(), spec);
+            ++written;
+        }
+        trans->Append(row.c_str());
+        ++written;
     }
+
+    // specs dropped since the last save
+    for (SavedRows::iterator itr = saved.lower_bound(m_specsCount); itr != saved.end();)
+    {
+        trans->PAppend("DELETE FROM character_branchspec WHERE guid='%u' AND spec='%u'", GetGUIDLow(), itr->first);
+        ++written;
+        saved.erase(itr++);
+    }
+
+    sPlayerSaveStats->AddSection(PLAYER_SAVE_BRANCH_SPECS, written, 1 + m_specsCount);
 }
 
 void Player::_LoadTalentBranchSpecs(PreparedQueryResult result)
@@ -43,6 +43,8 @@
 #include "DBCEnums.h"
 #include "MapInstanced.h"
 #include "AntiHack.h"
+#include "PlayerSaveStats.h"
+#include "ClientGUIDSet.h"
 
 #include<string>
 #include<vector>
@@ -1690,7 +1692,7 @@ class Player : public Unit, public GridObject<Player>
         void AddTimedQuest(uint32 quest_id) { m_timedquests.insert(quest_id); }
         void RemoveTimedQuest(uint32 quest_id) { m_timedquests.erase(quest_id); }
 
-        void SaveCUFProfile(uint8 id, CUFProfile* profile) { delete _CUFProfiles[id]; _CUFProfiles[id] = profile; } ///> Replaces a CUF profile at position 0-4
+        void SaveCUFProfile(uint8 id, CUFProfile* profile) { delete _CUFProfiles[id]; _CUFProfiles[id] = profile; _CUFProfilesChanged |= 1 << id; } ///> Replaces a CUF profile at position 0-4
         CUFProfile* GetCUFProfile(uint8 id) const { return _CUFProfiles[id]; } ///> Retrieves a CUF profile at position 0-4
         uint8 GetCUFProfilesCount() const
         {
@@ -1727,7 +1729,7 @@ class Player : public Unit, public GridObject<Player>
         void SaveInventoryAndGoldToDB(SQLTransaction& trans);                    // fast save function for item/money cheating preventing
         void SaveGoldToDB(SQLTransaction& trans);
 
-        void _SaveRatedBGData();
+        void _SaveRatedBGData(SQLTransaction& trans);
 
         static void SetUInt32ValueInArray(Tokens& data,uint16 index, uint32 value);
         static void SetFloatValueInArray(Tokens& data,uint16 index, float value);
@@ -2638,10 +2640,10 @@ class Player : public Unit, public GridObject<Player>
         void SendTooManyPets(Player *pl);
 
         // currently visible objects at player client
-        typedef std::set<uint64> ClientGUIDs;
+        typedef ClientGUIDSet ClientGUIDs;
         ClientGUIDs m_clientGUIDs;
 
-        bool HaveAtClient(WorldObject const* u) const { return u == this || m_clientGUIDs.find(u->GetGUID()) != m_clientGUIDs.end(); }
+        bool HaveAtClient(WorldObject const* u) const { return u == this || m_clientGUIDs.contains(u->GetGUID()); }
 
         bool canSeeOrDetect(Unit const* u, bool detect, bool inVisibleList = false, bool is3dDistance = true) const;
         bool IsVisibleInGridForPlayer(Player const* pl) const;
@@ -2655,7 +2657,7 @@ class Player : public Unit, public GridObject<Player>
         void HandleDelayedUpdateForPlayer(Creature * target);
 
         template<class T>
-            void UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& visibleNow);
+            void UpdateVisibilityOf(T* target, UpdateData& data, std::vector<Unit*>& visibleNow);
 
         // Stealth detection system
         void HandleStealthedUnitsDetection();
@@ -2991,12 +2993,43 @@ class Player : public Unit, public GridObject<Player>
         void _SaveGlyphs(SQLTransaction& trans);
         void _SaveTalents(SQLTransaction& trans);
         void _SaveTalentBranchSpecs(SQLTransaction& trans);
-        void _SaveCurrency();
-        void _SaveCurrencyWeekcap();
+        void _SaveCurrency(SQLTransaction& trans);
+        void _SaveCurrencyWeekcap(SQLTransaction& trans);
         void _SaveStats(SQLTransaction& trans);
         void _SaveArchaeologyData();
         void _SaveCUFProfiles(SQLTransaction& trans);
 
+        // Sections saved as whole rows keep the text of each row written, keyed by a section specific row id.
+        // No saved row means the section was not written yet this session, its first save rewrites all rows.
+        typedef std::map<uint32, std::string> SavedRows;
+        bool _IsSavedRowChanged(SavedRows& saved, uint32 key, std::string const& row);
+        void _ResetSavedRows();                             // the next save writes every section in full
+
+        struct SavedAura
+        {
+            bool operator==(SavedAura const& right) const;
+            bool operator!=(SavedAura const& right) const { return !(*this == right); }
+
+            uint64 casterGuid;
+            uint32 spellId;
+            uint8 effMask;
+            uint8 recalculateMask;
+            uint8 stackAmount;
+            uint8 charges;
+            int32 amount[MAX_SPELL_EFFECTS];
+            int32 baseAmount[MAX_SPELL_EFFECTS];
+            int32 maxDuration;
+            int32 duration;
+        };
+        typedef std::map<std::pair<uint64, uint64>, SavedAura> SavedAuraMap;   // (caster, spell and effect mask)
+
+        SavedRows m_savedRows[MAX_PLAYER_SAVE_SECTIONS];
+        SavedAuraMap m_savedAuras;
+        bool m_aurasSaved;
+        SpellCooldowns m_savedSpellCooldowns;
+        bool m_spellCooldownsSaved;
+        uint32 m_saveFailedTransactions;                    // TransactionTask::GetFailedCount() seen by the last save
+
         /*********************************************************/
         /***              ENVIRONMENTAL SYSTEM                 ***/
         /*********************************************************/
@@ -3030,6 +3063,7 @@ class Player : public Unit, public GridObject<Player>
         PlayerCurrenciesMap m_currencies;
 
         VoidStorageItem* _voidStorageItems[VOID_STORAGE_MAX_SLOT];
+        uint64 _voidStorageSavedIds[VOID_STORAGE_MAX_SLOT];     // item id saved in each slot, 0 for none, VOID_STORAGE_SLOT_UNSAVED before the first save
 
         std::vector<Item*> m_itemUpdateQueue;
         bool m_itemUpdateQueueBlocked;
@@ -3195,6 +3229,7 @@ class Player : public Unit, public GridObject<Player>
         EquipmentSets m_EquipmentSets;
 
         CUFProfile* _CUFProfiles[MAX_CUF_PROFILES];
+        uint8 _CUFProfilesChanged;                              // mask of the profiles replaced since the last save
     private:
         // internal common parts for CanStore/StoreItem functions
         uint8 _CanStoreItem_InSpecificSlot(uint8 bag, uint8 slot, ItemPosCountVec& dest, ItemPrototype const *pProto, uint32& count, bool swap, Item *pSrcItem) const;
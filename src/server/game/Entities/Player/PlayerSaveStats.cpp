@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://www.getmangos.com/>
+ *
+ * Copyright (C) 2008-2011 Trinity <http://www.trinitycore.org/>
+ *
+ * Copyright (C) 2010-2011 Project SkyFire <http://www.projectskyfire.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "gamePCH.h"
+#include "PlayerSaveStats.h"
+
+void PlayerSaveStats::AddSection(PlayerSaveSection section, uint32 written, uint32 rewriteCost)
+{
+    if (written)
+        m_written[section] += written;
+    if (rewriteCost > written)
+        m_skipped[section] += rewriteCost - written;
+}
+
+// counters updated meanwhile by the map threads may keep part of their old value
+void PlayerSaveStats::Reset()
+{
+    m_saves = 0;
+    m_statements = 0;
+    for (uint8 i = 0; i < MAX_PLAYER_SAVE_SECTIONS; ++i)
+    {
+        m_written[i] = 0;
+        m_skipped[i] = 0;
+    }
+}
+
+char const* PlayerSaveStats::GetSectionName(PlayerSaveSection section)
+{
+    switch (section)
+    {
+        case PLAYER_SAVE_AURAS:             return "auras";
+        case PLAYER_SAVE_SPELL_COOLDOWNS:   return "spell cooldowns";
+        case PLAYER_SAVE_VOID_STORAGE:      return "void storage";
+        case PLAYER_SAVE_CUF_PROFILES:      return "CUF profiles";
+        case PLAYER_SAVE_GLYPHS:            return "glyphs";
+        case PLAYER_SAVE_BRANCH_SPECS:      return "branch specs";
+        case PLAYER_SAVE_BG_DATA:           return "battleground data";
+        case PLAYER_SAVE_RATED_BG_DATA:     return "rated battleground data";
+        case PLAYER_SAVE_CURRENCY_WEEKCAP:  return "currency week caps";
+        case PLAYER_SAVE_RESEARCH:          return "archaeology";
+        case PLAYER_SAVE_STATS:             return "stats";
+        default:                            return "unknown";
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://www.getmangos.com/>
+ *
+ * Copyright (C) 2008-2011 Trinity <http://www.trinitycore.org/>
+ *
+ * Copyright (C) 2010-2011 Project SkyFire <http://www.projectskyfire.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef TRINITY_PLAYERSAVESTATS_H
+#define TRINITY_PLAYERSAVESTATS_H
+
+#include "Common.h"
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
+
+// Sections of Player::SaveToDB which only write the rows changed since the previous save
+enum PlayerSaveSection
+{
+    PLAYER_SAVE_AURAS,
+    PLAYER_SAVE_SPELL_COOLDOWNS,
+    PLAYER_SAVE_VOID_STORAGE,
+    PLAYER_SAVE_CUF_PROFILES,
+    PLAYER_SAVE_GLYPHS,
+    PLAYER_SAVE_BRANCH_SPECS,
+    PLAYER_SAVE_BG_DATA,
+    PLAYER_SAVE_RATED_BG_DATA,
+    PLAYER_SAVE_CURRENCY_WEEKCAP,
+    PLAYER_SAVE_RESEARCH,
+    PLAYER_SAVE_STATS,
+    MAX_PLAYER_SAVE_SECTIONS
+};
+
+/// Statements written by player saves, and the ones of each section a full rewrite would have needed.
+/// Players are saved from the map threads, the counters are atomic.
+class PlayerSaveStats
+{
+    friend class ACE_Singleton<PlayerSaveStats, ACE_Thread_Mutex>;
+    PlayerSaveStats() {}
+
+    public:
+        typedef ACE_Atomic_Op<ACE_Thread_Mutex, uint64> Counter;
+
+        void AddSave(uint32 statements) { ++m_saves; m_statements += statements; }
+        void AddSection(PlayerSaveSection section, uint32 written, uint32 rewriteCost);
+
+        uint64 GetSaves() const { return m_saves.value(); }
+        uint64 GetStatements() const { return m_statements.value(); }
+        uint64 GetWritten(PlayerSaveSection section) const { return m_written[section].value(); }
+        uint64 GetSkipped(PlayerSaveSection section) const { return m_skipped[section].value(); }
+
+        void Reset();
+
+        static char const* GetSectionName(PlayerSaveSection section);
+
+    private:
+        Counter m_saves;
+        Counter m_statements;                               // all statements of SaveToDB, not only the tracked sections
+        Counter m_written[MAX_PLAYER_SAVE_SECTIONS];
+        Counter m_skipped[MAX_PLAYER_SAVE_SECTIONS];        // statements of a full rewrite which were not needed
+};
+
+#define sPlayerSaveStats ACE_Singleton<PlayerSaveStats, ACE_Thread_Mutex>::instance()
+#endif
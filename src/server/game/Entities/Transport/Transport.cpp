@@ -668,11 +668,9 @@ void Transport::DoEventIfAny(KeyFrame const& node, bool departure)
 void Transport::BuildUpdate(UpdateDataMapType& data_map)
 {
     Map::PlayerList const& players = GetMap()->GetPlayers();
-    if (players.isEmpty())
-        return;
-
     for (Map::PlayerList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
         BuildFieldsUpdate(itr->getSource(), data_map);
 
-    ClearUpdateMask(true);
+    // already taken out of the ObjectAccessor queue by the caller
+    ClearUpdateMask(false);
 }
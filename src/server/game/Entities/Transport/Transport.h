@@ -36,6 +36,8 @@ public:
     void Update(uint32 diff);
 
     void BuildUpdate(UpdateDataMapType& data_map);
+    // transports change maps, their changes go through the global ObjectAccessor queue
+    Map* GetObjectUpdateMap() const { return NULL; }
 
     bool AddPassenger(WorldObject* passenger, int8 seatId = -1, bool byAura = false);
     void RemovePassenger(WorldObject* passenger);
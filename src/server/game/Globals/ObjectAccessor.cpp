@@ -196,21 +196,23 @@ Unit* ObjectAccessor::FindUnit(uint64 guid)
 
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
-    ACE_GUARD_RETURN(LockType, g, *HashMapHolder<Player>::GetLock(), NULL);
-    HashMapHolder<Player>::MapType& m = HashMapHolder<Player>::GetContainer();
-    for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->second->IsInWorld() && strcmp(name, iter->second->GetName()) == 0)
-            return iter->second;
+    HashMapHolder<Player>::ReadGuard guard;
+    std::vector<Player*> players;
+    GetPlayers(players, guard);
+    for (std::vector<Player*>::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+        if ((*itr)->IsInWorld() && strcmp(name, (*itr)->GetName()) == 0)
+            return *itr;
 
     return NULL;
 }
 
 void ObjectAccessor::SaveAllPlayers()
 {
-    ACE_GUARD(LockType, g, *HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = HashMapHolder<Player>::GetContainer();
-    for (HashMapHolder<Player>::MapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        itr->second->SaveToDB();
+    HashMapHolder<Player>::ReadGuard guard;
+    std::vector<Player*> players;
+    GetPlayers(players, guard);
+    for (std::vector<Player*>::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+        (*itr)->SaveToDB();
 }
 
 Corpse* ObjectAccessor::GetCorpseForPlayerGUID(uint64 guid)
@@ -398,8 +400,22 @@ void ObjectAccessor::Update(uint32 /*diff*/)
 
 /// Define the static members of HashMapHolder
 
-template <class T> std::unordered_map< uint64, T* > HashMapHolder<T>::m_objectMap;
-template <class T> ACE_Thread_Mutex HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::Shard HashMapHolder<T>::m_shards[HashMapHolder<T>::SHARD_COUNT];
+template <class T> ACE_Atomic_Op<ACE_Thread_Mutex, uint64> HashMapHolder<T>::m_contendedReads(0);
+template <class T> ACE_Atomic_Op<ACE_Thread_Mutex, uint64> HashMapHolder<T>::m_contendedWrites(0);
+
+template <class T> uint32 HashMapHolder<T>::GetCount()
+{
+    uint32 count = 0;
+    for (uint32 i = 0; i < SHARD_COUNT; ++i)
+    {
+        AcquireRead(m_shards[i]);
+        count += uint32(m_shards[i].objects.size());
+        m_shards[i].lock.release();
+    }
+
+    return count;
+}
 
 /// Global definitions for the hashmap storage
 
@@ -26,6 +26,8 @@
 #include "Define.h"
 #include <ace/Singleton.h>
 #include <ace/Thread_Mutex.h>
+#include <ace/RW_Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
 
 #include "UpdateData.h"
 
@@ -52,38 +54,137 @@ class HashMapHolder
     public:
 
         typedef std::unordered_map<uint64, T*> MapType;
-        typedef ACE_Thread_Mutex LockType;
+        typedef ACE_RW_Thread_Mutex LockType;
+
+        // The objects are spread over the shards by guid, every shard has a lock of its own.
+        // Lookups never wait for each other, only for an insert or remove in the same shard.
+        enum { SHARD_COUNT = 64 };
 
         static void Insert(T* o)
         {
-            ACE_GUARD(LockType, Guard, i_lock);
-            m_objectMap[o->GetGUID()] = o;
+            Shard& shard = GetShard(o->GetGUID());
+            AcquireWrite(shard);
+            shard.objects[o->GetGUID()] = o;
+            shard.lock.release();
         }
 
         static void Remove(T* o)
         {
-            ACE_GUARD(LockType, Guard, i_lock);
-            m_objectMap.erase(o->GetGUID());
+            Shard& shard = GetShard(o->GetGUID());
+            AcquireWrite(shard);
+            shard.objects.erase(o->GetGUID());
+            shard.lock.release();
         }
 
         static T* Find(uint64 guid)
         {
-            ACE_GUARD_RETURN(LockType, Guard, i_lock, NULL);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : NULL;
+            Shard& shard = GetShard(guid);
+            AcquireRead(shard);
+            typename MapType::const_iterator itr = shard.objects.find(guid);
+            T* object = (itr != shard.objects.end()) ? itr->second : NULL;
+            shard.lock.release();
+            return object;
         }
 
-        static MapType& GetContainer() { return m_objectMap; }
+        // read locks every shard, nothing is inserted or removed while it is held
+        class ReadGuard
+        {
+            public:
+                ReadGuard()
+                {
+                    for (uint32 i = 0; i < SHARD_COUNT; ++i)
+                        AcquireRead(m_shards[i]);
+                }
+
+                ~ReadGuard()
+                {
+                    for (uint32 i = SHARD_COUNT; i > 0; --i)
+                        m_shards[i - 1].lock.release();
+                }
+
+            private:
+                ReadGuard(ReadGuard const&);
+                ReadGuard& operator=(ReadGuard const&);
+        };
+
+        // read locks a single shard, inserts and removes in the other shards go on
+        class ShardReadGuard
+        {
+            public:
+                explicit ShardReadGuard(uint32 index) : m_index(index)
+                {
+                    AcquireRead(m_shards[m_index]);
+                }
+
+                ~ShardReadGuard()
+                {
+                    m_shards[m_index].lock.release();
+                }
+
+                uint32 GetIndex() const { return m_index; }
 
-        static LockType* GetLock() { return &i_lock; }
+            private:
+                ShardReadGuard(ShardReadGuard const&);
+                ShardReadGuard& operator=(ShardReadGuard const&);
+
+                uint32 m_index;
+        };
+
+        // the pointers are only safe to use as long as the ReadGuard is held
+        static void GetAll(std::vector<T*>& objects, ReadGuard const& /*guard*/)
+        {
+            for (uint32 i = 0; i < SHARD_COUNT; ++i)
+                for (typename MapType::const_iterator itr = m_shards[i].objects.begin(); itr != m_shards[i].objects.end(); ++itr)
+                    objects.push_back(itr->second);
+        }
+
+        // the pointers are only safe to use as long as the ShardReadGuard is held
+        static void GetAll(std::vector<T*>& objects, ShardReadGuard const& guard)
+        {
+            MapType const& shardObjects = m_shards[guard.GetIndex()].objects;
+            for (typename MapType::const_iterator itr = shardObjects.begin(); itr != shardObjects.end(); ++itr)
+                objects.push_back(itr->second);
+        }
+
+        // lock statistics, approximate
+        static uint32 GetCount();
+        static uint64 GetContendedReads() { return m_contendedReads.value(); }
+        static uint64 GetContendedWrites() { return m_contendedWrites.value(); }
 
     private:
 
+        struct Shard
+        {
+            LockType lock;
+            MapType objects;
+        };
+
+        static Shard& GetShard(uint64 guid) { return m_shards[uint32(guid) & (SHARD_COUNT - 1)]; }    // by the low guid, a counter
+
+        static void AcquireRead(Shard& shard)
+        {
+            if (shard.lock.tryacquire_read() == -1)
+            {
+                ++m_contendedReads;
+                shard.lock.acquire_read();
+            }
+        }
+
+        static void AcquireWrite(Shard& shard)
+        {
+            if (shard.lock.tryacquire_write() == -1)
+            {
+                ++m_contendedWrites;
+                shard.lock.acquire_write();
+            }
+        }
+
         //Non instanceable only static
         HashMapHolder() {}
 
-        static LockType i_lock;
-        static MapType  m_objectMap;
+        static Shard m_shards[SHARD_COUNT];
+        static ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_contendedReads;
+        static ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_contendedWrites;
 };
 
 class ObjectAccessor
@@ -205,22 +306,16 @@ class ObjectAccessor
         static Unit* FindUnit(uint64);
         Player* FindPlayerByName(const char* name);
 
-        // when using this, you must use the hashmapholder's lock
-        HashMapHolder<Player>::MapType& GetPlayers()
-        {
-            return HashMapHolder<Player>::GetContainer();
-        }
-
-        // when using this, you must use the hashmapholder's lock
-        HashMapHolder<Creature>::MapType& GetCreatures()
+        // all players in or out of world, only safe to use as long as the guard is held
+        void GetPlayers(std::vector<Player*>& players, HashMapHolder<Player>::ReadGuard const& guard)
         {
-            return HashMapHolder<Creature>::GetContainer();
+            HashMapHolder<Player>::GetAll(players, guard);
         }
 
-        // when using this, you must use the hashmapholder's lock
-        HashMapHolder<GameObject>::MapType& GetGameObjects()
+        // players of a single shard, only safe to use as long as the guard is held
+        void GetPlayers(std::vector<Player*>& players, HashMapHolder<Player>::ShardReadGuard const& guard)
         {
-            return HashMapHolder<GameObject>::GetContainer();
+            HashMapHolder<Player>::GetAll(players, guard);
         }
 
         template<class T> void AddObject(T* object)
@@ -241,6 +336,8 @@ class ObjectAccessor
 
         void SaveAllPlayers();
 
+        // only for objects not bound to a single map (see Object::GetObjectUpdateMap),
+        // everything else is queued and sent by its own Map at the end of Map::Update
         void AddUpdateObject(Object* obj)
         {
             ACE_GUARD(LockType, Guard, i_updateGuard);
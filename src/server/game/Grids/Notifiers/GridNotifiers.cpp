@@ -37,7 +37,7 @@ using namespace Trinity;
 void
 VisibleNotifier::SendToSelf()
 {
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
+    // at this moment the unmarked guids are the ones not found at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (TransportBase* transportBase = i_player.GetTransport())
     {
@@ -45,9 +45,9 @@ VisibleNotifier::SendToSelf()
         {
             for (std::set<WorldObject*>::const_iterator itr = transport->GetPassengers().begin(); itr != transport->GetPassengers().end(); ++itr)
             {
-                if (vis_guids.find((*itr)->GetGUID()) != vis_guids.end())
+                if (i_player.m_clientGUIDs.IsUnmarked((*itr)->GetGUID()))
                 {
-                    vis_guids.erase((*itr)->GetGUID());
+                    i_player.m_clientGUIDs.Mark((*itr)->GetGUID());
 
                     switch ((*itr)->GetTypeId())
                     {
@@ -70,7 +70,10 @@ VisibleNotifier::SendToSelf()
         }
     }
 
-    for (uint64 vis_guid : vis_guids)
+    std::vector<uint64> outOfRange;
+    i_player.m_clientGUIDs.GetUnmarked(outOfRange);
+
+    for (uint64 vis_guid : outOfRange)
     {
         i_player.m_clientGUIDs.erase(vis_guid);
         i_data.AddOutOfRangeGUID(vis_guid);
@@ -90,7 +93,7 @@ VisibleNotifier::SendToSelf()
     i_data.BuildPacket(&packet);
     i_player.GetSession()->SendPacket(&packet);
 
-    for (std::set<Unit*>::const_iterator it = i_visibleNow.begin(); it != i_visibleNow.end(); ++it)
+    for (std::vector<Unit*>::const_iterator it = i_visibleNow.begin(); it != i_visibleNow.end(); ++it)
         i_player.SendInitialVisiblePackets(*it);
 }
 
@@ -149,7 +152,7 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
     {
         Player* plr = iter->getSource();
 
-        vis_guids.erase(plr->GetGUID());
+        i_player.m_clientGUIDs.Mark(plr->GetGUID());
 
         i_player.UpdateVisibilityOf(plr,i_data,i_visibleNow);
 
@@ -168,7 +171,7 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
     {
         Creature * c = iter->getSource();
 
-        vis_guids.erase(c->GetGUID());
+        i_player.m_clientGUIDs.Mark(c->GetGUID());
 
         i_player.UpdateVisibilityOf(c,i_data,i_visibleNow);
 
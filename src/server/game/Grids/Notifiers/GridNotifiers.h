@@ -45,10 +45,10 @@ namespace Trinity
     {
         Player &i_player;
         UpdateData i_data;
-        std::set<Unit*> i_visibleNow;
-        Player::ClientGUIDs vis_guids;
+        std::vector<Unit*> i_visibleNow;
 
-        VisibleNotifier(Player &player) : i_player(player), i_data(player.GetMapId()), vis_guids(player.m_clientGUIDs) {}
+        // the objects found in range are marked in m_clientGUIDs, SendToSelf() destroys the unmarked ones
+        VisibleNotifier(Player &player) : i_player(player), i_data(player.GetMapId()) { player.m_clientGUIDs.StartPass(); }
         template<class T> void Visit(GridRefManager<T> &m);
         void SendToSelf(void);
     };
@@ -132,10 +132,11 @@ namespace Trinity
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
+        WorldPacketBroadcast i_broadcast;
         MessageDistDeliverer(WorldObject *src, WorldPacket *msg, float dist, bool own_team_only = false, Player const* skipped = NULL)
             : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , team((own_team_only && src->GetTypeId() == TYPEID_PLAYER) ? ((Player*)src)->GetTeam() : 0)
-            , skipped_receiver(skipped)
+            , skipped_receiver(skipped), i_broadcast(msg)
         {
         }
         void Visit(PlayerMapType &m);
@@ -164,10 +165,12 @@ namespace Trinity
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
+        WorldPacketBroadcast i_broadcastHostile;
+        WorldPacketBroadcast i_broadcastFriendly;
         MessageDistFactionDeliverer(Unit *src, WorldPacket *msg_hostile, WorldPacket *msg_friendly, float dist, bool own_team_only = false, Player const* skipped = NULL)
             : i_source(src), i_message_hostile(msg_hostile), i_message_friendly(msg_friendly), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , team((own_team_only && src->GetTypeId() == TYPEID_PLAYER) ? ((Player*)src)->GetTeam() : 0)
-            , skipped_receiver(skipped)
+            , skipped_receiver(skipped), i_broadcastHostile(msg_hostile), i_broadcastFriendly(msg_friendly)
         {
         }
         void Visit(PlayerMapType &m);
@@ -243,14 +246,15 @@ namespace Trinity
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
     };
 
-    template<class Check>
+    // Container may be any sequence of WorldObject* supporting push_back
+    template<class Check, class Container = std::list<WorldObject*> >
     struct WorldObjectListSearcher
     {
         uint32 i_phaseMask;
-        std::list<WorldObject*> &i_objects;
+        Container &i_objects;
         Check& i_check;
 
-        WorldObjectListSearcher(WorldObject const* searcher, std::list<WorldObject*> &objects, Check & check)
+        WorldObjectListSearcher(WorldObject const* searcher, Container &objects, Check & check)
             : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects),i_check(check) {}
 
         void Visit(PlayerMapType &m);
@@ -38,7 +38,7 @@ Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
 {
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        vis_guids.erase(iter->getSource()->GetGUID());
+        i_player.m_clientGUIDs.Mark(iter->getSource()->GetGUID());
         i_player.UpdateVisibilityOf(iter->getSource(),i_data,i_visibleNow);
     }
 }
@@ -175,8 +175,8 @@ void Trinity::WorldObjectSearcher<Check>::Visit(DynamicObjectMapType &m)
     }
 }
 
-template<class Check>
-void Trinity::WorldObjectListSearcher<Check>::Visit(PlayerMapType &m)
+template<class Check, class Container>
+void Trinity::WorldObjectListSearcher<Check, Container>::Visit(PlayerMapType &m)
 {
     for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
         if (itr->getSource()->InSamePhase(i_phaseMask))
@@ -184,16 +184,16 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(PlayerMapType &m)
                 i_objects.push_back(itr->getSource());
 }
 
-template<class Check>
-void Trinity::WorldObjectListSearcher<Check>::Visit(AreaTriggerMapType &m)
+template<class Check, class Container>
+void Trinity::WorldObjectListSearcher<Check, Container>::Visit(AreaTriggerMapType &m)
 {
     for (AreaTriggerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         if (i_check(itr->getSource()))
             i_objects.push_back(itr->getSource());
 }
 
-template<class Check>
-void Trinity::WorldObjectListSearcher<Check>::Visit(CreatureMapType &m)
+template<class Check, class Container>
+void Trinity::WorldObjectListSearcher<Check, Container>::Visit(CreatureMapType &m)
 {
     for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
         if (itr->getSource()->InSamePhase(i_phaseMask))
@@ -201,8 +201,8 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(CreatureMapType &m)
                 i_objects.push_back(itr->getSource());
 }
 
-template<class Check>
-void Trinity::WorldObjectListSearcher<Check>::Visit(CorpseMapType &m)
+template<class Check, class Container>
+void Trinity::WorldObjectListSearcher<Check, Container>::Visit(CorpseMapType &m)
 {
     for (CorpseMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
         if (itr->getSource()->InSamePhase(i_phaseMask))
@@ -210,8 +210,8 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(CorpseMapType &m)
                 i_objects.push_back(itr->getSource());
 }
 
-template<class Check>
-void Trinity::WorldObjectListSearcher<Check>::Visit(GameObjectMapType &m)
+template<class Check, class Container>
+void Trinity::WorldObjectListSearcher<Check, Container>::Visit(GameObjectMapType &m)
 {
     for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
         if (itr->getSource()->InSamePhase(i_phaseMask))
@@ -219,8 +219,8 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(GameObjectMapType &m)
                 i_objects.push_back(itr->getSource());
 }
 
-template<class Check>
-void Trinity::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType &m)
+template<class Check, class Container>
+void Trinity::WorldObjectListSearcher<Check, Container>::Visit(DynamicObjectMapType &m)
 {
     for (DynamicObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
         if (itr->getSource()->InSamePhase(i_phaseMask))
@@ -70,7 +70,7 @@ class LootTemplate::LootGroup                               // A set of loot def
         void CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_set) const;
         LootStoreItemList * GetExplicitlyChancedItemList() { return &ExplicitlyChanced; }
         LootStoreItemList * GetEqualChancedItemList() { return &EqualChanced; }
-        void CopyConditions(ConditionList conditions);
+        void CopyConditions(ConditionList const& conditions);
     private:
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
@@ -1119,7 +1119,7 @@ bool LootTemplate::LootGroup::HasQuestDropForPlayer(Player const * player) const
     return false;
 }
 
-void LootTemplate::LootGroup::CopyConditions(ConditionList /*conditions*/)
+void LootTemplate::LootGroup::CopyConditions(ConditionList const& /*conditions*/)
 {
     for (LootStoreItemList::iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
     {
@@ -1297,7 +1297,7 @@ void LootTemplate::AddEntry(LootStoreItem& item)
         Entries.push_back(item);
 }
 
-void LootTemplate::CopyConditions(ConditionList conditions)
+void LootTemplate::CopyConditions(ConditionList const& conditions)
 {
     for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
         i->conditions.clear();
@@ -1468,7 +1468,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
         {
             if (i->itemid == int32(cond->mSourceEntry))
             {
-                i->conditions.push_back(cond);
+                ConditionMgr::AddToConditionList(i->conditions, cond);
                 return true;
             }
         }
@@ -1484,7 +1484,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i).itemid == int32(cond->mSourceEntry))
                     {
-                        (*i).conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i).conditions, cond);
                         return true;
                     }
                 }
@@ -1496,7 +1496,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i).itemid == int32(cond->mSourceEntry))
                     {
-                        (*i).conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i).conditions, cond);
                         return true;
                     }
                 }
@@ -38,6 +38,8 @@
 #include "DynamicTree.h"
 #include "Vehicle.h"
 
+#include <ace/Mem_Map.h>
+
 union u_map_magic
 {
     char asChar[4];
@@ -73,8 +75,6 @@ Map::~Map()
 
     if (!m_scriptSchedule.empty())
         sWorld->DecreaseScheduledScriptCount(m_scriptSchedule.size());
-
-    MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
 }
 
 bool Map::ExistMap(uint32 mapid,int gx,int gy)
@@ -228,10 +228,12 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _par
 i_mapEntry (sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
-m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
-i_gridExpiry(expiry), i_scriptLock(false)
+m_updateTimeAvg(0), m_updateTimeLast(0), m_updateTimeMax(0),
+_transportsUpdateIter(_transports.end()),
+i_gridExpiry(expiry), i_scriptLock(false), m_useUpdateRegions(false)
 {
     m_parentMap = (_parent ? _parent : this);
+    m_useUpdateRegions = !Instanceable() && sWorld->getBoolConfig(CONFIG_MAP_UPDATE_REGIONS);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
     {
         for (unsigned int j=0; j < MAX_NUMBER_OF_GRIDS; ++j)
@@ -453,22 +455,31 @@ bool Map::EnsureGridLoaded(const Cell &cell)
     NGridType *grid = getNGrid(cell.GridX(), cell.GridY());
 
     ASSERT(grid != NULL);
-    if (!isGridObjectDataLoaded(cell.GridX(), cell.GridY()))
-    {
-        sLog->outDebug("Loading grid[%u,%u] for map %u instance %u", cell.GridX(), cell.GridY(), GetId(), i_InstanceId);
 
-        setGridObjectDataLoaded(true,cell.GridX(), cell.GridY());
+    // Update regions may load grids at the same time. A grid is flagged loaded before its objects are added,
+    // so they find it when they get back here. While any grid is loading, wait for the loading thread
+    // instead of trusting the flag; the lock is recursive, so the loading thread itself passes straight through.
+    if (isGridObjectDataLoaded(cell.GridX(), cell.GridY()) && !m_gridsLoading.value())
+        return false;
 
-        ObjectGridLoader loader(*grid, this, cell);
-        loader.LoadN();
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, m_gridLoadLock, false);
+    if (isGridObjectDataLoaded(cell.GridX(), cell.GridY()))
+        return false;
 
-        // Add resurrectable corpses to world object list in grid
-        sObjectAccessor->AddCorpsesToGrid(GridPair(cell.GridX(),cell.GridY()),(*grid)(cell.CellX(), cell.CellY()), this);
-        Balance();
-        return true;
-    }
+    sLog->outDebug("Loading grid[%u,%u] for map %u instance %u", cell.GridX(), cell.GridY(), GetId(), i_InstanceId);
 
-    return false;
+    ++m_gridsLoading;
+    setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
+
+    ObjectGridLoader loader(*grid, this, cell);
+    loader.LoadN();
+
+    // Add resurrectable corpses to world object list in grid
+    sObjectAccessor->AddCorpsesToGrid(GridPair(cell.GridX(),cell.GridY()),(*grid)(cell.CellX(), cell.CellY()), this);
+    Balance();
+
+    --m_gridsLoading;
+    return true;
 }
 
 void Map::LoadGrid(float x, float y)
@@ -498,6 +509,7 @@ bool Map::Add(Player *player)
     AddToGrid(player, grid, cell);
 
     player->AddToWorld();
+    RefreshActiveCells(player);
 
     SendInitSelf(player);
     SendInitTransports(player);
@@ -635,7 +647,10 @@ bool Map::loaded(const GridPair &p) const
 
 void Map::Update(const uint32 &t_diff)
 {
-    m_dyn_tree.update(t_diff);
+    {
+        DynamicTreeGuard guard(*this, true);
+        m_dyn_tree.update(t_diff);
+    }
 
     /// update players at tick
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -646,132 +661,346 @@ void Map::Update(const uint32 &t_diff)
     }
 
     /// update active cells around players and active objects
-    resetMarkedCells();
+    // the set is maintained on relocation, take a snapshot as updates may activate or release cells
+    m_cellsToUpdate.assign(m_activeCells.begin(), m_activeCells.end());
 
-    Trinity::ObjectUpdater updater(t_diff);
+    // with region updates enabled, clusters of cells far enough apart to not interact are updated in parallel
+    if (m_useUpdateRegions && sMapMgr->GetMapUpdater()->activated() && BuildUpdateRegions() > 1)
+    {
+        // immediate map scripts would touch objects all over the map, run them with the scheduled ones below
+        i_scriptLock = true;
+        sMapMgr->GetMapUpdater()->update_regions(*this, m_updateRegions.size(), t_diff);
+        i_scriptLock = false;
+    }
+    else
+        UpdateCells(m_cellsToUpdate, t_diff);
+
+    for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
+    {
+        WorldObject* obj = *_transportsUpdateIter;
+        ++_transportsUpdateIter;
+
+        if (!obj->IsInWorld() || obj->isActiveObject())
+            continue;
+
+        obj->Update(t_diff);
+    }
+
+    ///- Process necessary scripts
+    if (!m_scriptSchedule.empty())
+    {
+        i_scriptLock = true;
+        ScriptsProcess();
+        i_scriptLock = false;
+    }
+
+    MoveAllCreaturesInMoveList();
+    MoveAllGameObjectsInMoveList();
+
+    if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
+        ProcessRelocationNotifies(t_diff);
+
+    sScriptMgr->OnMapUpdate(this, t_diff);
+
+    SendObjectUpdates();
+}
+
+void Map::UpdateCells(std::vector<uint32> const& cells, uint32 diff)
+{
+    Trinity::ObjectUpdater updater(diff);
     // for creature
     TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
     // for pets
     TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    for (std::vector<uint32>::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
     {
-        Player* plr = m_mapRefIter->getSource();
+        CellPair pair(*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP, *itr / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        Cell cell(pair);
+        cell.data.Part.reserved = CENTER_DISTRICT;
+        //cell.SetNoCreate();
+        cell.Visit(pair, grid_object_update,  *this);
+        cell.Visit(pair, world_object_update, *this);
+    }
+}
 
-        if (!plr->IsInWorld())
-            continue;
+void Map::UpdateRegion(uint32 region, uint32 diff)
+{
+    ASSERT(region < m_updateRegions.size());
+    UpdateCells(m_updateRegions[region], diff);
+}
 
-        CellPair standing_cell(Trinity::ComputeCellPair(plr->GetPositionX(), plr->GetPositionY()));
+uint32 Map::BuildUpdateRegions()
+{
+    // Cells are clustered by grid: grids holding cells to update are joined when less than three grids apart,
+    // so two regions always have at least two whole grids (1066 yards) without active cells between them.
+    // Whatever spills over a region border (summons, chases, knockbacks) stays in grids no other region touches.
+    // Notifiers and spells reach at most MAX_VISIBILITY_DISTANCE (333 yards) from an updated cell, and every player
+    // stands in an active cell, so the players they visit (m_clientGUIDs, threat, auras) belong to the updating region.
+    const int32 REGION_GRID_DISTANCE = 2;
 
-        // Check for correctness of standing_cell, it also avoids problems with update_cell
-        if (standing_cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing_cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
-            continue;
+    m_updateRegionGrids.assign(MAX_NUMBER_OF_GRIDS * MAX_NUMBER_OF_GRIDS, UPDATE_REGION_NONE);
+    for (std::vector<std::vector<uint32> >::iterator itr = m_updateRegions.begin(); itr != m_updateRegions.end(); ++itr)
+        itr->clear();
 
-        // the overloaded operators handle range checking
-        // so ther's no need for range checking inside the loop
-        CellPair begin_cell(standing_cell), end_cell(standing_cell);
-        //lets update mobs/objects in ALL visible cells around player!
-        CellArea area = Cell::CalculateCellArea(*plr, GetVisibilityDistance());
-        area.ResizeBorders(begin_cell, end_cell);
+    std::vector<uint32> occupied;
+    for (std::vector<uint32>::const_iterator itr = m_cellsToUpdate.begin(); itr != m_cellsToUpdate.end(); ++itr)
+    {
+        uint32 gx = (*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP) / MAX_NUMBER_OF_CELLS;
+        uint32 gy = (*itr / TOTAL_NUMBER_OF_CELLS_PER_MAP) / MAX_NUMBER_OF_CELLS;
+        uint32 grid = gy * MAX_NUMBER_OF_GRIDS + gx;
+        if (m_updateRegionGrids[grid] == UPDATE_REGION_NONE)
+        {
+            m_updateRegionGrids[grid] = UPDATE_REGION_PENDING;
+            occupied.push_back(grid);
+        }
+    }
 
-        for (uint32 x = begin_cell.x_coord; x <= end_cell.x_coord; ++x)
+    uint32 regions = 0;
+    std::vector<uint32> stack;
+    for (std::vector<uint32>::const_iterator itr = occupied.begin(); itr != occupied.end(); ++itr)
+    {
+        if (m_updateRegionGrids[*itr] != UPDATE_REGION_PENDING)
+            continue;
+
+        m_updateRegionGrids[*itr] = regions;
+        stack.push_back(*itr);
+        while (!stack.empty())
         {
-            for (uint32 y = begin_cell.y_coord; y <= end_cell.y_coord; ++y)
+            int32 gx = stack.back() % MAX_NUMBER_OF_GRIDS;
+            int32 gy = stack.back() / MAX_NUMBER_OF_GRIDS;
+            stack.pop_back();
+
+            for (int32 x = std::max(gx - REGION_GRID_DISTANCE, 0); x <= std::min(gx + REGION_GRID_DISTANCE, int32(MAX_NUMBER_OF_GRIDS) - 1); ++x)
             {
-                // marked cells are those that have been visited
-                // don't visit the same cell twice
-                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                if (!isCellMarked(cell_id))
+                for (int32 y = std::max(gy - REGION_GRID_DISTANCE, 0); y <= std::min(gy + REGION_GRID_DISTANCE, int32(MAX_NUMBER_OF_GRIDS) - 1); ++y)
                 {
-                    markCell(cell_id);
-                    CellPair pair(x,y);
-                    Cell cell(pair);
-                    cell.data.Part.reserved = CENTER_DISTRICT;
-                    //cell.SetNoCreate();
-                    cell.Visit(pair, grid_object_update,  *this);
-                    cell.Visit(pair, world_object_update, *this);
+                    uint32 grid = y * MAX_NUMBER_OF_GRIDS + x;
+                    if (m_updateRegionGrids[grid] == UPDATE_REGION_PENDING)
+                    {
+                        m_updateRegionGrids[grid] = regions;
+                        stack.push_back(grid);
+                    }
                 }
             }
         }
+        ++regions;
     }
 
-    // non-player active objects
-    if (!m_activeNonPlayers.empty())
+    // Threat is not bound by distance: a creature keeps a player on its threat list wherever the player went,
+    // and its update adds and drops references in the player's HostileRefManager. Such pairs share a region.
+    if (regions > 1)
     {
-        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
-        {
-            // skip not in world
-            WorldObject* obj = *m_activeNonPlayersIter;
+        std::vector<uint32> merged(regions);
+        for (uint32 i = 0; i < regions; ++i)
+            merged[i] = i;
 
-            // step before processing, in this case if Map::Remove remove next object we correctly
-            // step to next-next, and if we step to end() then newly added objects can wait next update.
-            ++m_activeNonPlayersIter;
-
-            if (!obj->IsInWorld())
+        for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+        {
+            Player* plr = itr->getSource();
+            if (!plr || !plr->isInCombat())
                 continue;
 
-            CellPair standing_cell(Trinity::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY()));
-
-            // Check for correctness of standing_cell, it also avoids problems with update_cell
-            if (standing_cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing_cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+            uint32 playerRegion = GetUpdateRegionOf(plr, merged);
+            if (playerRegion == UPDATE_REGION_NONE)
                 continue;
 
-            // the overloaded operators handle range checking
-            // so ther's no need for range checking inside the loop
-            CellPair begin_cell(standing_cell), end_cell(standing_cell);
-            begin_cell << 1; begin_cell -= 1;               // upper left
-            end_cell >> 1; end_cell += 1;                   // lower right
-
-            for (uint32 x = begin_cell.x_coord; x <= end_cell.x_coord; ++x)
+            for (HostileReference* ref = plr->getHostileRefManager().getFirst(); ref; ref = ref->next())
             {
-                for (uint32 y = begin_cell.y_coord; y <= end_cell.y_coord; ++y)
-                {
-                    // marked cells are those that have been visited
-                    // don't visit the same cell twice
-                    uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                    if (!isCellMarked(cell_id))
-                    {
-                        markCell(cell_id);
-                        CellPair pair(x,y);
-                        Cell cell(pair);
-                        cell.data.Part.reserved = CENTER_DISTRICT;
-                        //cell.SetNoCreate();
-                        cell.Visit(pair, grid_object_update,  *this);
-                        cell.Visit(pair, world_object_update, *this);
-                    }
-                }
+                uint32 threatRegion = GetUpdateRegionOf(ref->getSourceUnit(), merged);
+                if (threatRegion == UPDATE_REGION_NONE || threatRegion == playerRegion)
+                    continue;
+
+                merged[std::max(threatRegion, playerRegion)] = std::min(threatRegion, playerRegion);
+                playerRegion = std::min(threatRegion, playerRegion);
             }
         }
+
+        // renumber the regions left after merging, merged[i] <= i so roots come first
+        std::vector<uint32> renumbered(regions);
+        uint32 count = 0;
+        for (uint32 i = 0; i < regions; ++i)
+            renumbered[i] = (merged[i] == i) ? count++ : renumbered[RootUpdateRegion(merged, i)];
+
+        for (std::vector<uint32>::const_iterator itr = occupied.begin(); itr != occupied.end(); ++itr)
+            m_updateRegionGrids[*itr] = renumbered[RootUpdateRegion(merged, m_updateRegionGrids[*itr])];
+
+        regions = count;
     }
 
-    for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
+    m_updateRegions.resize(regions);
+
+    for (std::vector<uint32>::const_iterator itr = m_cellsToUpdate.begin(); itr != m_cellsToUpdate.end(); ++itr)
     {
-        WorldObject* obj = *_transportsUpdateIter;
-        ++_transportsUpdateIter;
+        uint32 gx = (*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP) / MAX_NUMBER_OF_CELLS;
+        uint32 gy = (*itr / TOTAL_NUMBER_OF_CELLS_PER_MAP) / MAX_NUMBER_OF_CELLS;
+        m_updateRegions[m_updateRegionGrids[gy * MAX_NUMBER_OF_GRIDS + gx]].push_back(*itr);
+    }
 
-        if (!obj->IsInWorld() || obj->isActiveObject())
-            continue;
+    return regions;
+}
 
-        obj->Update(t_diff);
+uint32 Map::RootUpdateRegion(std::vector<uint32> const& merged, uint32 region)
+{
+    while (merged[region] != region)
+        region = merged[region];
+    return region;
+}
+
+uint32 Map::GetUpdateRegionOf(WorldObject const* obj, std::vector<uint32> const& merged) const
+{
+    CellPair p = Trinity::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
+    if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        return UPDATE_REGION_NONE;
+
+    uint32 region = m_updateRegionGrids[(p.y_coord / MAX_NUMBER_OF_CELLS) * MAX_NUMBER_OF_GRIDS + p.x_coord / MAX_NUMBER_OF_CELLS];
+    if (region == UPDATE_REGION_NONE)
+        return UPDATE_REGION_NONE;                          // not updated this tick
+
+    return RootUpdateRegion(merged, region);
+}
+
+bool Map::GetActiveCellBounds(WorldObject const* obj, ActiveCellBounds& bounds) const
+{
+    CellPair standing_cell(Trinity::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY()));
+
+    // Check for correctness of standing_cell, it also avoids problems with update_cell
+    if (standing_cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing_cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        return false;
+
+    // the overloaded operators handle range checking
+    CellPair begin_cell(standing_cell), end_cell(standing_cell);
+    if (obj->GetTypeId() == TYPEID_PLAYER)
+    {
+        //lets update mobs/objects in ALL visible cells around player!
+        CellArea area = Cell::CalculateCellArea(*obj, GetVisibilityDistance());
+        area.ResizeBorders(begin_cell, end_cell);
+    }
+    else
+    {
+        begin_cell << 1; begin_cell -= 1;                   // upper left
+        end_cell >> 1; end_cell += 1;                       // lower right
     }
 
-    ///- Process necessary scripts
-    if (!m_scriptSchedule.empty())
+    bounds.begin_x = begin_cell.x_coord;
+    bounds.begin_y = begin_cell.y_coord;
+    bounds.end_x = end_cell.x_coord;
+    bounds.end_y = end_cell.y_coord;
+    return true;
+}
+
+void Map::RefreshActiveCells(WorldObject* obj)
+{
+    ActiveCellBounds bounds;
+    if (!GetActiveCellBounds(obj, bounds))
     {
-        i_scriptLock = true;
-        ScriptsProcess();
-        i_scriptLock = false;
+        ReleaseActiveCells(obj);
+        return;
     }
 
-    MoveAllCreaturesInMoveList();
-    MoveAllGameObjectsInMoveList();
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_activeCellsLock);
 
-    if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
-        ProcessRelocationNotifies(t_diff);
+    std::unordered_map<WorldObject*, ActiveCellBounds>::iterator itr = m_activeCellOwners.find(obj);
+    if (itr == m_activeCellOwners.end())
+    {
+        AcquireActiveCells(bounds, NULL);
+        m_activeCellOwners[obj] = bounds;
+        return;
+    }
 
-    sScriptMgr->OnMapUpdate(this, t_diff);
+    if (itr->second == bounds)
+        return;
+
+    // only the cells entering or leaving the rectangle change their reference count
+    AcquireActiveCells(bounds, &itr->second);
+    ReleaseActiveCells(itr->second, &bounds);
+    itr->second = bounds;
+}
+
+void Map::ReleaseActiveCells(WorldObject* obj)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_activeCellsLock);
+
+    std::unordered_map<WorldObject*, ActiveCellBounds>::iterator itr = m_activeCellOwners.find(obj);
+    if (itr == m_activeCellOwners.end())
+        return;
+
+    ReleaseActiveCells(itr->second, NULL);
+    m_activeCellOwners.erase(itr);
+}
+
+void Map::AcquireActiveCells(ActiveCellBounds const& bounds, ActiveCellBounds const* except)
+{
+    for (uint32 x = bounds.begin_x; x <= bounds.end_x; ++x)
+    {
+        for (uint32 y = bounds.begin_y; y <= bounds.end_y; ++y)
+        {
+            if (except && except->Contains(x, y))
+                continue;
+
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            ActiveCellRef& ref = m_activeCellRefs[cell_id];
+            if (ref.refs++ == 0)
+            {
+                ref.index = m_activeCells.size();
+                m_activeCells.push_back(cell_id);
+                markCell(cell_id);
+            }
+        }
+    }
+}
+
+void Map::ReleaseActiveCells(ActiveCellBounds const& bounds, ActiveCellBounds const* except)
+{
+    for (uint32 x = bounds.begin_x; x <= bounds.end_x; ++x)
+    {
+        for (uint32 y = bounds.begin_y; y <= bounds.end_y; ++y)
+        {
+            if (except && except->Contains(x, y))
+                continue;
+
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            std::unordered_map<uint32, ActiveCellRef>::iterator itr = m_activeCellRefs.find(cell_id);
+            ASSERT(itr != m_activeCellRefs.end());
+            if (--itr->second.refs)
+                continue;
+
+            // swap the last active cell into the freed slot
+            uint32 last = m_activeCells.back();
+            m_activeCells[itr->second.index] = last;
+            m_activeCellRefs[last].index = itr->second.index;
+            m_activeCells.pop_back();
+
+            m_activeCellRefs.erase(itr);
+            marked_cells.reset(cell_id);
+        }
+    }
+}
+
+void Map::SendObjectUpdates()
+{
+    UpdateDataMapType update_players;
+
+    // Critical section
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, _updateObjectsLock);
+
+        while (!_updateObjects.empty())
+        {
+            Object* obj = *_updateObjects.begin();
+            ASSERT(obj && obj->IsInWorld());
+            _updateObjects.erase(_updateObjects.begin());
+            obj->BuildUpdate(update_players);
+        }
+    }
+
+    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    {
+        iter->second.BuildPacket(&packet);
+        iter->first->GetSession()->SendPacket(&packet);
+        packet.clear();                                     // clean the string
+    }
 }
 
 struct ResetNotifier
@@ -866,6 +1095,7 @@ void Map::ProcessRelocationNotifies(const uint32 & diff)
 void Map::Remove(Player *player, bool remove)
 {
     player->RemoveFromWorld();
+    ReleaseActiveCells(player);
     SendRemoveTransports(player);
 
     CellPair p = Trinity::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
@@ -999,6 +1229,7 @@ Map::PlayerRelocation(Player *player, float x, float y, float z, float orientati
         AddToGrid(player, newGrid,new_cell);
     }
 
+    RefreshActiveCells(player);
     player->UpdateObjectVisibility(false);
 }
 
@@ -1073,6 +1304,7 @@ void Map::AddCreatureToMoveList(Creature *c, float x, float y, float z, float an
     if (!c)
         return;
 
+    ACE_GUARD(ACE_Thread_Mutex, guard, i_objectListsLock);
     i_creaturesToMove[c] = CreatureMover(x, y, z, ang);
 }
 
@@ -1081,6 +1313,7 @@ void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, flo
     if (!go)
         return;
 
+    ACE_GUARD(ACE_Thread_Mutex, guard, i_objectListsLock);
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         i_gameObjectsToMove.push_back(go);
     go->SetNewCellPosition(x, y, z, ang);
@@ -1118,6 +1351,8 @@ void Map::MoveAllCreaturesInMoveList()
         {
             // update pos
             c->Relocate(cm.x, cm.y, cm.z, cm.ang);
+            if (c->isActiveObject())
+                RefreshActiveCells(c);
             //CreatureRelocationNotify(c,new_cell,new_cell.cellPair());
             c->UpdateObjectVisibility(false);
             c->SetRelocatedFlag();
@@ -1162,6 +1397,8 @@ void Map::MoveAllGameObjectsInMoveList()
         {
             // update pos
             go->Relocate(go->_newPosition);
+            if (go->isActiveObject())
+                RefreshActiveCells(go);
             go->UpdateObjectVisibility(false);
         }
         else
@@ -1311,6 +1548,8 @@ bool Map::CreatureRespawnRelocation(Creature *c)
     if (CreatureCellRelocation(c,resp_cell))
     {
         c->Relocate(resp_x, resp_y, resp_z, resp_o);
+        if (c->isActiveObject())
+            RefreshActiveCells(c);
         c->GetMotionMaster()->Initialize();                 // prevent possible problems with default move generators
         //CreatureRelocationNotify(c,resp_cell,resp_cell.cellPair());
         c->UpdateObjectVisibility(false);
@@ -1334,6 +1573,8 @@ bool Map::GameObjectRespawnRelocation(GameObject* go, bool diffGridOnly)
     if (GameObjectCellRelocation(go, resp_cell))
     {
         go->Relocate(resp_x, resp_y, resp_z, resp_o);
+        if (go->isActiveObject())
+            RefreshActiveCells(go);
         go->UpdateObjectVisibility(false);
         return true;
     }
@@ -1468,6 +1709,11 @@ GridMap::GridMap()
     m_liquidEntry = NULL;
     m_liquidFlags = NULL;
     m_liquidMap  = NULL;
+    // File data
+    m_mapping = NULL;
+    m_fileData = NULL;
+    m_file = NULL;
+    m_fileSize = 0;
 }
 
 GridMap::~GridMap()
@@ -1480,57 +1726,54 @@ bool GridMap::loadData(char* filename)
     // Unload old data if exist
     unloadData();
 
-    map_fileheader header;
-    // Not return error if file not found
-    FILE *in = fopen(filename, "rb");
-    if (!in)
-        return true;
-
-    if (fread(&header, sizeof(header),1,in) != 1)
+    if (!sWorld->getBoolConfig(CONFIG_TERRAIN_MEMORY_MAP) || !mapFile(filename))
     {
-        fclose(in);
-        return false;
+        if (!readFile(filename))
+            return false;
+
+        // Not return error if file not found
+        if (!m_file)
+            return true;
     }
 
+    map_fileheader header;
+    if (!readHeader(0, header))
+        return false;
+
     if (header.mapMagic == uint32(MAP_MAGIC) && (header.versionMagic == uint32(MAP_VERSION_MAGIC) || header.versionMagic == uint32(MAP_VERSION_MAGIC_ALT)))
     {
         // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header.areaMapOffset && !loadAreaData(header.areaMapOffset))
         {
             sLog->outError("Error loading map area data\n");
-            fclose(in);
             return false;
         }
         // loadup height data
-        if (header.heightMapOffset && !loadHeihgtData(in, header.heightMapOffset, header.heightMapSize))
+        if (header.heightMapOffset && !loadHeihgtData(header.heightMapOffset))
         {
             sLog->outError("Error loading map height data\n");
-            fclose(in);
             return false;
         }
         // loadup liquid data
-        if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header.liquidMapOffset && !loadLiquidData(header.liquidMapOffset))
         {
             sLog->outError("Error loading map liquids data\n");
-            fclose(in);
             return false;
         }
-        fclose(in);
         return true;
     }
     sLog->outError("Map file '%s' is from an incompatible clientversion. Please recreate using the mapextractor.", filename);
-    fclose(in);
     return false;
 }
 
 void GridMap::unloadData()
 {
-    delete[] m_area_map;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] m_liquidEntry;
-    delete[] m_liquidFlags;
-    delete[] m_liquidMap;
+    freeArray(m_area_map);
+    freeArray(m_V9);
+    freeArray(m_V8);
+    freeArray(m_liquidEntry);
+    freeArray(m_liquidFlags);
+    freeArray(m_liquidMap);
     m_area_map = NULL;
     m_V9 = NULL;
     m_V8 = NULL;
@@ -1538,70 +1781,153 @@ void GridMap::unloadData()
     m_liquidFlags = NULL;
     m_liquidMap  = NULL;
     m_gridGetHeight = &GridMap::getHeightFromFlat;
+
+    delete m_mapping;
+    delete[] m_fileData;
+    m_mapping = NULL;
+    m_fileData = NULL;
+    m_file = NULL;
+    m_fileSize = 0;
 }
 
-bool GridMap::loadAreaData(FILE *in, uint32 offset, uint32 /*size*/)
+bool GridMap::mapFile(char const* filename)
 {
-    map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
+    // map() instead of the mapping constructor, which logs an error for every missing file and most grids have none
+    ACE_Mem_Map* mapping = new ACE_Mem_Map();
+    if (mapping->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_SHARED) == -1)
+    {
+        delete mapping;
+        return false;
+    }
+
+    uint8 const* base = static_cast<uint8 const*>(mapping->addr());
+    if (!base || base == MAP_FAILED || !mapping->size())
+    {
+        delete mapping;
+        return false;
+    }
+
+#ifdef MADV_WILLNEED
+    // start reading the file in the background, the map thread only waits for pages it touches before they arrive
+    mapping->advise(MADV_WILLNEED);
+#endif
+
+    m_mapping = mapping;
+    m_file = base;
+    m_fileSize = uint32(mapping->size());
+    return true;
+}
+
+bool GridMap::readFile(char const* filename)
+{
+    FILE *in = fopen(filename, "rb");
+    if (!in)
+        return true;
+
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+
+    if (size <= 0)
+    {
+        fclose(in);
+        return false;
+    }
+
+    m_fileData = new uint8[size];
+    dontDump(m_fileData, int(size));
+    if (fread(m_fileData, size, 1, in) != 1)
+    {
+        fclose(in);
+        return false;
+    }
+    fclose(in);
+
+    m_file = m_fileData;
+    m_fileSize = uint32(size);
+    return true;
+}
+
+template<class T>
+bool GridMap::readHeader(uint32 offset, T& header) const
+{
+    if (offset > m_fileSize || m_fileSize - offset < sizeof(T))
+        return false;
+
+    memcpy(&header, m_file + offset, sizeof(T));
+    return true;
+}
+
+template<class T>
+bool GridMap::getArray(uint32 offset, uint32 count, T*& array)
+{
+    if (offset > m_fileSize || (m_fileSize - offset) / sizeof(T) < count)
+        return false;
+
+    uint8 const* data = m_file + offset;
+    if (reinterpret_cast<uintptr_t>(data) % sizeof(T) == 0)
+        array = reinterpret_cast<T*>(const_cast<uint8*>(data));
+    else
+    {
+        // the extractor does not pad the sections, copy what would be read unaligned
+        uint8* copy = new uint8[count * sizeof(T)];
+        dontDump(copy, int(count * sizeof(T)));
+        memcpy(copy, data, count * sizeof(T));
+        array = reinterpret_cast<T*>(copy);
+    }
+    return true;
+}
+
+void GridMap::freeArray(void* array)
+{
+    uint8* data = static_cast<uint8*>(array);
+    if (data && (data < m_file || data >= m_file + m_fileSize))
+        delete[] data;
+}
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != uint32(MAP_AREA_MAGIC))
+bool GridMap::loadAreaData(uint32 offset)
+{
+    map_areaHeader header;
+    if (!readHeader(offset, header) || header.fourcc != uint32(MAP_AREA_MAGIC))
         return false;
 
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
-    {
-        m_area_map = new uint16 [16*16];
-        dontDump(m_area_map, sizeof(uint16)*16*16);
-        if (fread(m_area_map, sizeof(uint16), 16*16, in) != 16*16)
+        if (!getArray(offset + sizeof(header), 16*16, m_area_map))
             return false;
-    }
     return true;
 }
 
-bool GridMap::loadHeihgtData(FILE *in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeihgtData(uint32 offset)
 {
     map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != uint32(MAP_HEIGHT_MAGIC))
+    if (!readHeader(offset, header) || header.fourcc != uint32(MAP_HEIGHT_MAGIC))
         return false;
 
+    offset += sizeof(header);
     m_gridHeight = header.gridHeight;
     if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            dontDump(m_uint16_V9, sizeof(uint16) * 129 * 129);
-            dontDump(m_uint16_V8, sizeof(uint16) * 128 * 128);
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
+            if (!getArray(offset, 129*129, m_uint16_V9) ||
+                !getArray(offset + sizeof(uint16)*129*129, 128*128, m_uint16_V8))
                 return false;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            dontDump(m_uint8_V9, sizeof(uint8) * 129 * 129);
-            dontDump(m_uint8_V8, sizeof(uint8) * 128 * 128);
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
+            if (!getArray(offset, 129*129, m_uint8_V9) ||
+                !getArray(offset + sizeof(uint8)*129*129, 128*128, m_uint8_V8))
                 return false;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            dontDump(m_V9, sizeof(float) * 129 * 129);
-            dontDump(m_V8, sizeof(float) * 128 * 128);
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
+            if (!getArray(offset, 129*129, m_V9) ||
+                !getArray(offset + sizeof(float)*129*129, 128*128, m_V8))
                 return false;
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
@@ -1612,12 +1938,10 @@ bool GridMap::loadHeihgtData(FILE *in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool  GridMap::loadLiquidData(FILE *in, uint32 offset, uint32 /*size*/)
+bool  GridMap::loadLiquidData(uint32 offset)
 {
     map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != uint32(MAP_LIQUID_MAGIC))
+    if (!readHeader(offset, header) || header.fourcc != uint32(MAP_LIQUID_MAGIC))
         return false;
 
     m_liquidType  = header.liquidType;
@@ -1627,23 +1951,20 @@ bool  GridMap::loadLiquidData(FILE *in, uint32 offset, uint32 /*size*/)
     m_liquidHeight= header.height;
     m_liquidLevel  = header.liquidLevel;
 
+    offset += sizeof(header);
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16 [16*16];
-        dontDump(m_liquidEntry, sizeof(uint16) * 16 * 16);
-        if (fread(m_liquidEntry, sizeof(uint16), 16*16, in) != 16*16)
+        if (!getArray(offset, 16*16, m_liquidEntry))
             return false;
+        offset += sizeof(uint16)*16*16;
 
-        m_liquidFlags = new uint8[16*16];
-        dontDump(m_liquidFlags, sizeof(uint8) * 16 * 16);
-        if (fread(m_liquidFlags, sizeof(uint8), 16*16, in) != 16*16)
+        if (!getArray(offset, 16*16, m_liquidFlags))
             return false;
+        offset += sizeof(uint8)*16*16;
     }
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquidMap = new float [m_liquidWidth*m_liquidHeight];
-        dontDump(m_liquidMap, sizeof(float) * m_liquidWidth * m_liquidHeight);
-        if (fread(m_liquidMap, sizeof(float), m_liquidWidth*m_liquidHeight, in) != m_liquidWidth*m_liquidHeight)
+        if (!getArray(offset, m_liquidWidth*m_liquidHeight, m_liquidMap))
             return false;
     }
     return true;
@@ -2045,7 +2366,11 @@ float Map::GetWaterOrGroundLevel(float x, float y, float z, float* ground /*= NU
 
 GameObject* Map::GetGroundCollisionObject(float x, float y, float z, uint32 phaseMask)
 {
-    GameObjectModel* colmodel = m_dyn_tree.getFirstCollisionModel(x, y, z, DEFAULT_HEIGHT_SEARCH*3.0f, phaseMask);
+    GameObjectModel* colmodel;
+    {
+        DynamicTreeGuard guard(*this, false);
+        colmodel = m_dyn_tree.getFirstCollisionModel(x, y, z, DEFAULT_HEIGHT_SEARCH*3.0f, phaseMask);
+    }
     if (!colmodel)
         return NULL;
 
@@ -2054,13 +2379,19 @@ GameObject* Map::GetGroundCollisionObject(float x, float y, float z, uint32 phas
 
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2)
-        && m_dyn_tree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
+    if (!VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2))
+        return false;
+
+    DynamicTreeGuard guard(*this, false);
+    return m_dyn_tree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
 }
 
 float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool vmap/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
 {
-    return std::max<float>(GetHeight(x, y, z, vmap, maxSearchDist), m_dyn_tree.getHeight(x, y, z, maxSearchDist, phasemask));
+    float staticHeight = GetHeight(x, y, z, vmap, maxSearchDist);
+
+    DynamicTreeGuard guard(*this, false);
+    return std::max<float>(staticHeight, m_dyn_tree.getHeight(x, y, z, maxSearchDist, phasemask));
 }
 
 float Map::GetHeight(float x, float y, float z, bool pUseVmaps, float maxSearchDist) const
@@ -2550,6 +2881,7 @@ void Map::AddObjectToRemoveList(WorldObject *obj)
 
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
+    ACE_GUARD(ACE_Thread_Mutex, guard, i_objectListsLock);
     i_objectsToRemove.insert(obj);
     //sLog->outDebug("Object (GUID: %u TypeId: %u) added to removing list.",obj->GetGUIDLow(),obj->GetTypeId());
 }
@@ -2558,6 +2890,7 @@ void Map::AddObjectToSwitchList(WorldObject *obj, bool on)
 {
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    ACE_GUARD(ACE_Thread_Mutex, guard, i_objectListsLock);
     std::map<WorldObject*, bool>::iterator itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -2634,6 +2967,7 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    WorldPacketBroadcast broadcast(data);
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
         itr->getSource()->GetSession()->SendPacket(data);
 }
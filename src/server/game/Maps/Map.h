@@ -26,6 +26,8 @@
 #include "Define.h"
 #include <ace/RW_Thread_Mutex.h>
 #include <ace/Thread_Mutex.h>
+#include <ace/Recursive_Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
 
 #include "DBCStructure.h"
 #include "GridDefines.h"
@@ -57,6 +59,7 @@ class Battleground;
 class MapInstanced;
 class InstanceMap;
 class Transport;
+class ACE_Mem_Map;
 
 struct ScriptAction
 {
@@ -191,9 +194,23 @@ class GridMap
     uint8 m_liquidWidth;
     uint8 m_liquidHeight;
 
-    bool  loadAreaData(FILE *in, uint32 offset, uint32 size);
-    bool  loadHeihgtData(FILE *in, uint32 offset, uint32 size);
-    bool  loadLiquidData(FILE *in, uint32 offset, uint32 size);
+    // The whole .map file, either memory mapped read only (pages are shared with the page cache
+    // and only read in when touched) or read into m_fileData. The data arrays above point into it,
+    // only arrays misaligned in the file are copied.
+    ACE_Mem_Map* m_mapping;
+    uint8* m_fileData;
+    uint8 const* m_file;
+    uint32 m_fileSize;
+
+    bool  mapFile(char const* filename);
+    bool  readFile(char const* filename);
+    template<class T> bool readHeader(uint32 offset, T& header) const;
+    template<class T> bool getArray(uint32 offset, uint32 count, T*& array);
+    void  freeArray(void* array);
+
+    bool  loadAreaData(uint32 offset);
+    bool  loadHeihgtData(uint32 offset);
+    bool  loadLiquidData(uint32 offset);
 
     // Get height functions and pointers
     typedef float (GridMap::*pGetHeightPtr) (float x, float y) const;
@@ -256,6 +273,22 @@ enum LevelRequirementVsMode
 
 typedef std::unordered_map<Creature*, CreatureMover> CreatureMoveList;
 
+// rectangle of cells kept active by a player or an active object, end coordinates inclusive
+struct ActiveCellBounds
+{
+    uint32 begin_x, begin_y, end_x, end_y;
+
+    bool Contains(uint32 x, uint32 y) const
+    {
+        return x >= begin_x && x <= end_x && y >= begin_y && y <= end_y;
+    }
+
+    bool operator==(ActiveCellBounds const& other) const
+    {
+        return begin_x == other.begin_x && begin_y == other.begin_y && end_x == other.end_x && end_y == other.end_y;
+    }
+};
+
 #define MAX_HEIGHT            100000.0f                     // can be use for find ground height at surface
 #define INVALID_HEIGHT       -100000.0f                     // for check, must be equal to VMAP_INVALID_HEIGHT, real value for unknown height is VMAP_INVALID_HEIGHT_VALUE
 #define MAX_FALL_DISTANCE     250000.0f                     // "unlimited fall" to find VMap ground if it is available, just larger than MAX_HEIGHT - INVALID_HEIGHT
@@ -289,6 +322,23 @@ class Map : public GridRefManager<NGridType>
 
         virtual void Update(const uint32&);
 
+        // update time bookkeeping of the MapUpdater scheduler, all values in microseconds
+        uint32 GetUpdateTimeEstimate() const { return m_updateTimeAvg; }
+        uint32 GetLastUpdateTime() const { return m_updateTimeLast; }
+        uint32 GetMaxUpdateTime() const { return m_updateTimeMax; }
+        void RecordUpdateTime(uint32 time)
+        {
+            // exponential moving average, one tick weights 1/8
+            m_updateTimeAvg = m_updateTimeLast ? (m_updateTimeAvg * 7 + time) / 8 : time;
+            m_updateTimeLast = time;
+            if (time > m_updateTimeMax)
+                m_updateTimeMax = time;
+        }
+        void ResetUpdateTimeMax() { m_updateTimeMax = 0; }
+
+        // updates the objects in the cells of one update region, called by MapUpdater::update_regions
+        void UpdateRegion(uint32 region, uint32 diff);
+
         float GetVisibilityDistance() const { return m_VisibleDistance; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
@@ -441,8 +491,16 @@ class Map : public GridRefManager<NGridType>
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(uint32 x, uint32 y) const;
 
-        void AddWorldObject(WorldObject *obj) { i_worldObjects.insert(obj); }
-        void RemoveWorldObject(WorldObject *obj) { i_worldObjects.erase(obj); }
+        void AddWorldObject(WorldObject *obj)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, i_objectListsLock);
+            i_worldObjects.insert(obj);
+        }
+        void RemoveWorldObject(WorldObject *obj)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, i_objectListsLock);
+            i_worldObjects.erase(obj);
+        }
 
         void SendToPlayers(WorldPacket const* data) const;
 
@@ -466,6 +524,7 @@ class Map : public GridRefManager<NGridType>
         template<class NOTIFIER> void VisitWorld(const float &x, const float &y, float radius, NOTIFIER &notifier);
         template<class NOTIFIER> void VisitGrid(const float &x, const float &y, float radius, NOTIFIER &notifier);
         CreatureGroupHolderType CreatureGroupHolder;
+        ACE_Thread_Mutex CreatureGroupHolderLock;           // grids of different update regions may load at the same time
 
         void UpdateIteratorBack(Player *player);
 
@@ -486,16 +545,44 @@ class Map : public GridRefManager<NGridType>
 
         float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
-        void Balance() { m_dyn_tree.balance(); }
-        void Remove(const GameObjectModel& mdl) { m_dyn_tree.remove(mdl); }
-        void Insert(const GameObjectModel& mdl) { m_dyn_tree.insert(mdl); }
-        bool Contains(const GameObjectModel& mdl) const { return m_dyn_tree.contains(mdl);}
+        void Balance()
+        {
+            DynamicTreeGuard guard(*this, true);
+            m_dyn_tree.balance();
+        }
+        void Remove(const GameObjectModel& mdl)
+        {
+            DynamicTreeGuard guard(*this, true);
+            m_dyn_tree.remove(mdl);
+        }
+        void Insert(const GameObjectModel& mdl)
+        {
+            DynamicTreeGuard guard(*this, true);
+            m_dyn_tree.insert(mdl);
+        }
+        bool Contains(const GameObjectModel& mdl) const
+        {
+            DynamicTreeGuard guard(*this, false);
+            return m_dyn_tree.contains(mdl);
+        }
 
         GameObject* GetGroundCollisionObject(float x, float y, float z, uint32 phaseMask);
 
         void SendInitTransports(Player* player);
         void SendRemoveTransports(Player* player);
 
+        void AddUpdateObject(Object* obj)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, _updateObjectsLock);
+            _updateObjects.insert(obj);
+        }
+
+        void RemoveUpdateObject(Object* obj)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, _updateObjectsLock);
+            _updateObjects.erase(obj);
+        }
+
     private:
         void LoadMapAndVMap(int gx, int gy);
         void LoadVMap(int gx, int gy);
@@ -537,6 +624,12 @@ class Map : public GridRefManager<NGridType>
 
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         void ScriptsProcess();
+        void SendObjectUpdates();
+
+        void UpdateCells(std::vector<uint32> const& cells, uint32 diff);
+        uint32 BuildUpdateRegions();
+        uint32 GetUpdateRegionOf(WorldObject const* obj, std::vector<uint32> const& merged) const;
+        static uint32 RootUpdateRegion(std::vector<uint32> const& merged, uint32 region);
 
         void UpdateActiveCells(const float &x, const float &y, const uint32 &t_diff);
     protected:
@@ -551,15 +644,47 @@ class Map : public GridRefManager<NGridType>
         float m_VisibleDistance;
 
         DynamicMapTree m_dyn_tree;
+        mutable ACE_RW_Thread_Mutex m_dynTreeLock;           // gameobjects of grids loading in one update region change the tree others search
+
+        // locks m_dynTreeLock on maps updated in regions, the only ones searching and changing the tree from several threads
+        class DynamicTreeGuard
+        {
+            public:
+                DynamicTreeGuard(Map const& map, bool write) : m_lock(map.m_useUpdateRegions ? &map.m_dynTreeLock : NULL)
+                {
+                    if (!m_lock)
+                        return;
+
+                    if (write)
+                        m_lock->acquire_write();
+                    else
+                        m_lock->acquire_read();
+                }
+
+                ~DynamicTreeGuard()
+                {
+                    if (m_lock)
+                        m_lock->release();
+                }
+
+            private:
+                DynamicTreeGuard(DynamicTreeGuard const&);
+                DynamicTreeGuard& operator=(DynamicTreeGuard const&);
+
+                ACE_RW_Thread_Mutex* m_lock;
+        };
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
 
         int32 m_VisibilityNotifyPeriod;
 
+        uint32 m_updateTimeAvg;
+        uint32 m_updateTimeLast;
+        uint32 m_updateTimeMax;
+
         typedef std::set<WorldObject*> ActiveNonPlayers;
         ActiveNonPlayers m_activeNonPlayers;
-        ActiveNonPlayers::iterator m_activeNonPlayersIter;
 
         // Objects that must update even in inactive grids without activating them
         typedef std::set<GameObject*> TransportsContainer;
@@ -596,6 +721,49 @@ class Map : public GridRefManager<NGridType>
         std::set<WorldObject*> i_worldObjects;
         std::multimap<time_t, ScriptAction> m_scriptSchedule;
 
+        // cells around players and active objects visited this tick, and their split into update regions
+        enum
+        {
+            UPDATE_REGION_NONE    = 0xFFFFFFFF,
+            UPDATE_REGION_PENDING = 0xFFFFFFFE
+        };
+
+        bool m_useUpdateRegions;
+        std::vector<uint32> m_cellsToUpdate;
+        std::vector<std::vector<uint32> > m_updateRegions;
+        std::vector<uint32> m_updateRegionGrids;            // region of each grid, only valid inside BuildUpdateRegions
+
+        // protects the move, remove, switch, active and world object lists and m_scriptSchedule,
+        // they are filled from all update regions at once
+        ACE_Thread_Mutex i_objectListsLock;
+
+        // serializes grid loading between update regions, m_gridsLoading counts the loads in progress
+        ACE_Recursive_Thread_Mutex m_gridLoadLock;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_gridsLoading;
+
+        // cells kept active by players and active objects, reference counted and updated on relocation
+        // instead of being marked again every tick; marked_cells mirrors the set for ProcessRelocationNotifies
+        struct ActiveCellRef
+        {
+            uint32 refs;
+            uint32 index;                                   // position in m_activeCells
+        };
+
+        bool GetActiveCellBounds(WorldObject const* obj, ActiveCellBounds& bounds) const;
+        void RefreshActiveCells(WorldObject* obj);
+        void ReleaseActiveCells(WorldObject* obj);
+        void AcquireActiveCells(ActiveCellBounds const& bounds, ActiveCellBounds const* except);
+        void ReleaseActiveCells(ActiveCellBounds const& bounds, ActiveCellBounds const* except);
+
+        std::unordered_map<uint32 /*cell id*/, ActiveCellRef> m_activeCellRefs;
+        std::vector<uint32> m_activeCells;
+        std::unordered_map<WorldObject*, ActiveCellBounds> m_activeCellOwners;
+        ACE_Thread_Mutex m_activeCellsLock;
+
+        // objects with changed fields, packets are built and sent at the end of Update()
+        std::set<Object*> _updateObjects;
+        ACE_Thread_Mutex _updateObjectsLock;
+
         // Type specific code for add/remove to/from grid
         template<class T>
             void AddToGrid(T*, NGridType *, Cell const&);
@@ -609,24 +777,21 @@ class Map : public GridRefManager<NGridType>
         template<class T>
         void AddToActiveHelper(T* obj)
         {
-            m_activeNonPlayers.insert(obj);
+            {
+                ACE_GUARD(ACE_Thread_Mutex, guard, i_objectListsLock);
+                m_activeNonPlayers.insert(obj);
+            }
+            RefreshActiveCells(obj);
         }
 
         template<class T>
         void RemoveFromActiveHelper(T* obj)
         {
-            // Map::Update for active object in proccess
-            if (m_activeNonPlayersIter != m_activeNonPlayers.end())
             {
-                ActiveNonPlayers::iterator itr = m_activeNonPlayers.find(obj);
-                if (itr == m_activeNonPlayers.end())
-                    return;
-                if (itr == m_activeNonPlayersIter)
-                    ++m_activeNonPlayersIter;
-                m_activeNonPlayers.erase(itr);
-            }
-            else
+                ACE_GUARD(ACE_Thread_Mutex, guard, i_objectListsLock);
                 m_activeNonPlayers.erase(obj);
+            }
+            ReleaseActiveCells(obj);
         }
 };
 
@@ -344,3 +344,19 @@ uint32 MapManager::GetNumPlayersInInstances()
     }
     return ret;
 }
+
+void MapManager::GetAllMaps(std::vector<Map*>& maps)
+{
+    ACE_GUARD(ACE_Thread_Mutex, Guard, Lock);
+
+    for (MapMapType::iterator itr = i_maps.begin(); itr != i_maps.end(); ++itr)
+    {
+        Map *map = itr->second;
+        maps.push_back(map);
+        if (!map->Instanceable())
+            continue;
+        MapInstanced::InstancedMaps &instances = ((MapInstanced *)map)->GetInstancedMaps();
+        for (MapInstanced::InstancedMaps::iterator mitr = instances.begin(); mitr != instances.end(); ++mitr)
+            maps.push_back(mitr->second);
+    }
+}
@@ -136,6 +136,8 @@ class MapManager
         /* statistics */
         uint32 GetNumInstances();
         uint32 GetNumPlayersInInstances();
+        // base maps followed by their instances, only meaningful while maps are not being updated
+        void GetAllMaps(std::vector<Map*>& maps);
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
 
@@ -22,133 +22,393 @@
 
 #include "gamePCH.h"
 #include "MapUpdater.h"
-#include "DelayExecutor.h"
 #include "Map.h"
 #include "DatabaseEnv.h"
 
 #include <ace/Guard_T.h>
-#include <ace/Method_Request.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_sys_time.h>
 
-class WDBThreadStartReq1 : public ACE_Method_Request
+#include <algorithm>
+
+static uint32 GetUSTimeDiff(ACE_Time_Value const& start)
 {
-    public:
+    ACE_Time_Value diff = ACE_OS::gettimeofday() - start;
+    return uint32(diff.sec() * 1000000 + diff.usec());
+}
 
-        WDBThreadStartReq1()
-        {
-        }
+bool MapUpdater::CompareTaskCost(UpdateTask const& a, UpdateTask const& b)
+{
+    return a.cost > b.cost;
+}
 
-        virtual int call()
-        {
-            return 0;
-        }
-};
+MapUpdater::MapUpdater():
+m_mutex(), m_workCondition(m_mutex), m_finishedCondition(m_mutex), pending_requests(0), m_queuedTasks(0),
+m_nextThreadIndex(0), m_dispatched(false), m_activated(false), m_shutdown(false), m_lastTickTime(0), m_maxTickTime(0)
+{
+}
 
-class WDBThreadEndReq1 : public ACE_Method_Request
+MapUpdater::~MapUpdater()
 {
-    public:
+    deactivate();
+}
 
-        WDBThreadEndReq1()
-        {
-        }
+int MapUpdater::activate(size_t num_threads)
+{
+    if (m_activated || num_threads < 1)
+        return -1;
 
-        virtual int call()
-        {
-            return 0;
-        }
-};
+    for (size_t i = 0; i < num_threads; ++i)
+        m_workers.push_back(new WorkerQueue());
+
+    m_shutdown = false;
+    m_nextThreadIndex = 0;
+
+    if (ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, int(num_threads)) == -1)
+    {
+        for (size_t i = 0; i < m_workers.size(); ++i)
+            delete m_workers[i];
+        m_workers.clear();
+        return -1;
+    }
+
+    m_activated = true;
+    return 0;
+}
 
-class MapUpdateRequest : public ACE_Method_Request
+int MapUpdater::deactivate()
 {
-    private:
+    if (!m_activated)
+        return -1;
+
+    wait();
 
-        Map& m_map;
-        MapUpdater& m_updater;
-        ACE_UINT32 m_diff;
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+        m_shutdown = true;
+        m_workCondition.broadcast();
+    }
 
-    public:
+    ACE_Task_Base::wait();
 
-        MapUpdateRequest(Map& m, MapUpdater& u, ACE_UINT32 d)
-            : m_map(m), m_updater(u), m_diff(d)
-        {
-        }
+    for (size_t i = 0; i < m_workers.size(); ++i)
+        delete m_workers[i];
+    m_workers.clear();
+
+    m_activated = false;
+    return 0;
+}
+
+bool MapUpdater::activated()
+{
+    return m_activated;
+}
+
+int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
+{
+    UpdateTask task(&map, diff, map.GetUpdateTimeEstimate());
+
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+        ++pending_requests;
 
-        virtual int call()
+        // the tick has not started yet, keep the map until wait() can order the whole batch
+        if (!m_dispatched)
         {
-            m_map.Update (m_diff);
-            m_updater.update_finished ();
+            m_batch.push_back(task);
             return 0;
         }
-};
+    }
 
-MapUpdater::MapUpdater():
-m_executor(), m_mutex(), m_condition(m_mutex), pending_requests(0)
-{
+    // scheduled from a running update (instances of a MapInstanced)
+    push_task(least_loaded_worker(), task);
+    return 0;
 }
 
-MapUpdater::~MapUpdater()
+int MapUpdater::wait()
 {
-    deactivate();
+    ACE_Time_Value tickStart = ACE_OS::gettimeofday();
+
+    std::vector<UpdateTask> batch;
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+        batch.swap(m_batch);
+        m_dispatched = true;
+    }
+
+    if (!batch.empty())
+    {
+        // longest processing time first: hand out the most expensive maps first,
+        // each one to the thread with the least work assigned so far
+        std::stable_sort(batch.begin(), batch.end(), CompareTaskCost);
+        for (std::vector<UpdateTask>::const_iterator itr = batch.begin(); itr != batch.end(); ++itr)
+            push_task(least_loaded_worker(), *itr);
+    }
+
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+        while (pending_requests > 0)
+            m_finishedCondition.wait();
+
+        m_dispatched = false;
+    }
+
+    if (!batch.empty())
+    {
+        m_lastTickTime = GetUSTimeDiff(tickStart);
+        m_maxTickTime = std::max(m_maxTickTime, m_lastTickTime);
+    }
+
+    return 0;
 }
 
-int MapUpdater::activate(size_t num_threads)
+int MapUpdater::update_regions(Map& map, size_t regions, ACE_UINT32 diff)
 {
-    return m_executor.activate((int)num_threads, new WDBThreadStartReq1, new WDBThreadEndReq1);
+    RegionBatch batch;
+    batch.pending = regions;
+
+    uint32 cost = map.GetUpdateTimeEstimate() / uint32(regions);
+    for (size_t i = 0; i < regions; ++i)
+        push_task(least_loaded_worker(), UpdateTask(&map, diff, cost, &batch, uint32(i)));
+
+    for (;;)
+    {
+        UpdateTask task(NULL, 0, 0);
+        if (take_region_task(&batch, task))
+        {
+            run_region_task(task);
+            continue;
+        }
+
+        // the remaining regions are being updated by other threads
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+        if (batch.pending == 0)
+            break;
+
+        m_finishedCondition.wait();
+    }
+
+    return 0;
 }
 
-int MapUpdater::deactivate()
+int MapUpdater::svc()
 {
-    wait();
+    size_t index;
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+        index = m_nextThreadIndex++;
+    }
+
+    for (;;)
+    {
+        UpdateTask task(NULL, 0, 0);
+        if (pop_task(index, task))
+        {
+            run_task(index, task, false);
+            continue;
+        }
+
+        if (steal_task(index, task))
+        {
+            run_task(index, task, true);
+            continue;
+        }
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+        while (!m_shutdown && m_queuedTasks == 0)
+            m_workCondition.wait();
+
+        if (m_shutdown && m_queuedTasks == 0)
+            break;
+    }
 
-    return m_executor.deactivate();
+    return 0;
 }
 
-int MapUpdater::wait()
+void MapUpdater::push_task(size_t worker, UpdateTask const& task)
 {
-    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+    // count the task before it can be seen, a worker may pop it and decrement
+    // the count as soon as the queue lock is released
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+        ++m_queuedTasks;
+    }
 
-    while (pending_requests > 0)
-        m_condition.wait();
+    WorkerQueue* queue = m_workers[worker];
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, queue->lock);
+        std::deque<UpdateTask>::iterator pos = std::upper_bound(queue->tasks.begin(), queue->tasks.end(), task, CompareTaskCost);
+        queue->tasks.insert(pos, task);
+        queue->queuedCost += task.cost;
+    }
 
-    return 0;
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+    m_workCondition.signal();
 }
 
-int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
+bool MapUpdater::pop_task(size_t worker, UpdateTask& task)
 {
-    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+    WorkerQueue* queue = m_workers[worker];
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, queue->lock, false);
+        if (queue->tasks.empty())
+            return false;
 
-    ++pending_requests;
+        task = queue->tasks.front();
+        queue->tasks.pop_front();
+        queue->queuedCost -= task.cost;
+    }
 
-    if (m_executor.execute(new MapUpdateRequest(map, *this, diff)) == -1)
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, false);
+    --m_queuedTasks;
+    return true;
+}
+
+bool MapUpdater::steal_task(size_t thief, UpdateTask& task)
+{
+    // rob the thread with the most estimated work left
+    size_t victim = thief;
+    uint64 victimCost = 0;
+    bool found = false;
+    for (size_t i = 0; i < m_workers.size(); ++i)
     {
-        ACE_DEBUG((LM_ERROR, ACE_TEXT("(%t) \n"), ACE_TEXT("Failed to schedule Map Update")));
+        if (i == thief)
+            continue;
 
-        using namespace std;
-        cout << "failed to schedule map update" << endl
-             << "pending requests: " << pending_requests << endl;
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_workers[i]->lock, false);
+        if (m_workers[i]->tasks.empty())
+            continue;
 
-        --pending_requests;
-        return -1;
+        if (!found || m_workers[i]->queuedCost > victimCost)
+        {
+            victim = i;
+            victimCost = m_workers[i]->queuedCost;
+            found = true;
+        }
     }
 
-    return 0;
+    // the victim may have drained its queue meanwhile, the caller simply retries
+    return found && pop_task(victim, task);
 }
 
-bool MapUpdater::activated()
+bool MapUpdater::take_region_task(RegionBatch const* batch, UpdateTask& task)
 {
-    return m_executor.activated();
+    bool found = false;
+    for (size_t i = 0; i < m_workers.size() && !found; ++i)
+    {
+        WorkerQueue* queue = m_workers[i];
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, queue->lock, false);
+        for (std::deque<UpdateTask>::iterator itr = queue->tasks.begin(); itr != queue->tasks.end(); ++itr)
+        {
+            if (itr->batch != batch)
+                continue;
+
+            task = *itr;
+            queue->tasks.erase(itr);
+            queue->queuedCost -= task.cost;
+            found = true;
+            break;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, false);
+    --m_queuedTasks;
+    return true;
+}
+
+size_t MapUpdater::least_loaded_worker()
+{
+    size_t best = 0;
+    uint64 bestCost = 0;
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_workers[i]->lock, best);
+        if (i == 0 || m_workers[i]->queuedCost < bestCost)
+        {
+            best = i;
+            bestCost = m_workers[i]->queuedCost;
+        }
+    }
+    return best;
+}
+
+uint32 MapUpdater::run_region_task(UpdateTask const& task)
+{
+    ACE_Time_Value start = ACE_OS::gettimeofday();
+    task.map->UpdateRegion(task.region, task.diff);
+    uint32 elapsed = GetUSTimeDiff(start);
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, elapsed);
+    if (--task.batch->pending == 0)
+        m_finishedCondition.broadcast();
+
+    return elapsed;
 }
 
-void MapUpdater::update_finished()
+void MapUpdater::run_task(size_t worker, UpdateTask const& task, bool stolen)
 {
+    if (task.batch)
+    {
+        uint32 elapsed = run_region_task(task);
+
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_workers[worker]->lock);
+        m_workers[worker]->stats.busyTime += elapsed;
+        return;
+    }
+
+    ACE_Time_Value start = ACE_OS::gettimeofday();
+    task.map->Update(task.diff);
+    uint32 elapsed = GetUSTimeDiff(start);
+
+    // the map is not touched by anyone else until the next tick, so no lock is needed here
+    task.map->RecordUpdateTime(elapsed);
+
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_workers[worker]->lock);
+        MapUpdaterThreadStats& stats = m_workers[worker]->stats;
+        ++stats.updates;
+        if (stolen)
+            ++stats.steals;
+        stats.busyTime += elapsed;
+    }
+
     ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
 
     if (pending_requests == 0)
     {
-        ACE_ERROR((LM_ERROR, ACE_TEXT("(%t)\n"), ACE_TEXT("MapUpdater::update_finished BUG, report to devs")));
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%t)\n"), ACE_TEXT("MapUpdater::run_task BUG, report to devs")));
         return;
     }
 
     --pending_requests;
+    if (pending_requests == 0)
+        m_finishedCondition.broadcast();
+}
+
+void MapUpdater::GetThreadStats(std::vector<MapUpdaterThreadStats>& stats) const
+{
+    stats.clear();
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_workers[i]->lock);
+        stats.push_back(m_workers[i]->stats);
+    }
+}
+
+void MapUpdater::ResetStats()
+{
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_workers[i]->lock);
+        m_workers[i]->stats = MapUpdaterThreadStats();
+    }
 
-    m_condition.broadcast();
+    m_lastTickTime = 0;
+    m_maxTickTime = 0;
 }
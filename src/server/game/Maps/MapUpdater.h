@@ -23,40 +23,109 @@
 #ifndef _MAP_UPDATER_H_INCLUDED
 #define _MAP_UPDATER_H_INCLUDED
 
+#include <ace/Task.h>
 #include <ace/Thread_Mutex.h>
 #include <ace/Condition_Thread_Mutex.h>
 
-#include "DelayExecutor.h"
+#include "Define.h"
+
+#include <deque>
+#include <vector>
 
 class Map;
 
-class MapUpdater
+struct MapUpdaterThreadStats
+{
+    MapUpdaterThreadStats() : updates(0), steals(0), busyTime(0) {}
+
+    uint32 updates;                                         // maps updated by this thread
+    uint32 steals;                                          // of those, taken from another thread's queue
+    uint64 busyTime;                                        // microseconds spent in Map::Update
+};
+
+class MapUpdater : protected ACE_Task_Base
 {
     public:
 
         MapUpdater();
         virtual ~MapUpdater();
 
-        friend class MapUpdateRequest;
-
         int schedule_update(Map& map, ACE_UINT32 diff);
 
         int wait();
 
+        // runs Map::UpdateRegion for every region of a map being updated by the calling thread,
+        // which works on the regions itself instead of blocking while the others help
+        int update_regions(Map& map, size_t regions, ACE_UINT32 diff);
+
         int activate(size_t num_threads);
 
         int deactivate();
 
         bool activated();
 
+        virtual int svc();
+
+        // statistics, only consistent when called between two wait() calls
+        void GetThreadStats(std::vector<MapUpdaterThreadStats>& stats) const;
+        uint32 GetLastTickTime() const { return m_lastTickTime; }
+        uint32 GetMaxTickTime() const { return m_maxTickTime; }
+        void ResetStats();
+
     private:
 
-        DelayExecutor m_executor;
+        struct RegionBatch
+        {
+            size_t pending;                                 // regions not finished yet, guarded by m_mutex
+        };
+
+        struct UpdateTask
+        {
+            UpdateTask(Map* m, ACE_UINT32 d, uint32 c, RegionBatch* b = NULL, uint32 r = 0) : map(m), diff(d), cost(c), batch(b), region(r) {}
+
+            Map* map;
+            ACE_UINT32 diff;
+            uint32 cost;                                    // estimated update time at scheduling
+            RegionBatch* batch;                             // set for a single region of a map, NULL for the whole map
+            uint32 region;
+        };
+
+        // tasks are kept ordered by descending estimated cost, the owner and thieves both take from the front
+        struct WorkerQueue
+        {
+            WorkerQueue() : queuedCost(0) {}
+
+            ACE_Thread_Mutex lock;
+            std::deque<UpdateTask> tasks;
+            uint64 queuedCost;
+            MapUpdaterThreadStats stats;
+        };
+
+        static bool CompareTaskCost(UpdateTask const& a, UpdateTask const& b);
+
+        void push_task(size_t worker, UpdateTask const& task);
+        bool pop_task(size_t worker, UpdateTask& task);
+        bool steal_task(size_t thief, UpdateTask& task);
+        size_t least_loaded_worker();
+        bool take_region_task(RegionBatch const* batch, UpdateTask& task);
+        void run_task(size_t worker, UpdateTask const& task, bool stolen);
+        uint32 run_region_task(UpdateTask const& task);
+
+        std::vector<WorkerQueue*> m_workers;
+        std::vector<UpdateTask> m_batch;                    // maps scheduled for the tick that has not been dispatched yet
+
         ACE_Thread_Mutex m_mutex;
-        ACE_Condition_Thread_Mutex m_condition;
+        ACE_Condition_Thread_Mutex m_workCondition;
+        ACE_Condition_Thread_Mutex m_finishedCondition;
         size_t pending_requests;
-
-        void update_finished();
+        size_t m_queuedTasks;                               // counted before a task is queued, never below the queued tasks
+        size_t m_nextThreadIndex;
+        bool m_dispatched;
+        bool m_activated;
+        bool m_shutdown;
+
+        uint32 m_lastTickTime;
+        uint32 m_maxTickTime;
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
@@ -33,21 +33,13 @@ _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
 _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _straightLine(false),
 _forceSource(false),
 _endPosition(G3D::Vector3::zero()), _sourceUnit(owner), _navMesh(NULL),
-_navMeshQuery(NULL),
+_navMeshQuery(NULL), _queryLease(NULL),
 _needAlternation(false)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
     sLog->outDebug("++ PathGenerator::PathGenerator for %u \n", _sourceUnit->GetGUIDLow());
 
-    uint32 mapId = _sourceUnit->GetMapId();
-    if (MMAP::MMapFactory::IsPathfindingEnabled(mapId))
-    {
-        MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _sourceUnit->GetInstanceId());
-    }
-
     CreateFilter();
 }
 
@@ -79,6 +71,13 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 
     sLog->outDebug("++ PathGenerator::CalculatePath() for %u \n", _sourceUnit->GetGUIDLow());
 
+    // the mesh and the query are ours until the lease goes out of scope, none of them may be kept beyond this call
+    uint32 mapId = _sourceUnit->GetMapId();
+    MMAP::NavMeshQueryLease lease(MMAP::MMapFactory::IsPathfindingEnabled(mapId) ? MMAP::MMapFactory::createOrGetMMapManager() : NULL, mapId);
+    _queryLease = &lease;
+    _navMesh = lease.GetNavMesh();
+    _navMeshQuery = lease.GetNavMeshQuery();
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     if (!_navMesh || !_navMeshQuery || _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING) ||
@@ -86,19 +85,23 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
     {
         BuildShortcut(start, dest);
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-        return true;
     }
+    else
+    {
+        UpdateFilter();
 
-    UpdateFilter();
-
-    // test if path alternation is needed
-    VerifyAlternation(start, dest);
+        // test if path alternation is needed
+        VerifyAlternation(start, dest);
 
-    BuildPolyPath(start, dest);
+        BuildPolyPath(start, dest);
 
-    // if alternation was needed, proceed
-    ProcessAlternation();
+        // if alternation was needed, proceed
+        ProcessAlternation();
+    }
 
+    _queryLease = NULL;
+    _navMesh = NULL;
+    _navMeshQuery = NULL;
     return true;
 }
 
@@ -614,6 +617,12 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                 return;
             }
         }
+        else if (_queryLease->GetCachedPath(startPoly, endPoly, _filter, _pathPolyRefs, _polyLength, MAX_PATH_LENGTH))
+        {
+            // the same corridor was searched recently, e.g. by another chaser of the same target
+            sLog->outDebug("++ BuildPolyPath :: cached path of %u polys\n", _polyLength);
+            dtResult = DT_SUCCESS;
+        }
         else
         {
             dtResult = _navMeshQuery->findPath(
@@ -625,6 +634,11 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                 _pathPolyRefs,     // [out] path
                 (int*)&_polyLength,
                 MAX_PATH_LENGTH);   // max number of polygons in output path
+
+            // only complete corridors, a partial one depends on the search limits
+            if (dtStatusSucceed(dtResult) && !dtStatusDetail(dtResult, DT_PARTIAL_RESULT) &&
+                _polyLength && _pathPolyRefs[_polyLength - 1] == endPoly)
+                _queryLease->StoreCachedPath(startPoly, endPoly, _filter, _pathPolyRefs, _polyLength);
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
@@ -26,6 +26,11 @@
 
 class Unit;
 
+namespace MMAP
+{
+    class NavMeshQueryLease;
+}
+
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
 // I think we can safely cut those down even more
@@ -112,8 +117,9 @@ private:
     G3D::Vector3 _actualEndPosition;    // {x, y, z} of the closest possible point to given destination
 
     Unit const* const _sourceUnit;          // the unit that is moving
-    dtNavMesh const* _navMesh;              // the nav mesh
-    dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
+    dtNavMesh const* _navMesh;              // the nav mesh, only set inside CalculatePath()
+    dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path, only set inside CalculatePath()
+    MMAP::NavMeshQueryLease* _queryLease;   // pooled query and path cache of the map, only set inside CalculatePath()
 
     G3D::Vector3 _storedStartPosition;      // stored starting position in case of path alternation
     G3D::Vector3 _storedEndPosition;        // stored ending position in case of path alternation
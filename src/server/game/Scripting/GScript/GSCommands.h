@@ -1,6 +1,8 @@
 #ifndef GSCR_COMMANDS_H
 #define GSCR_COMMANDS_H
 
+#include <ace/Atomic_Op.h>
+
 // parsed lexeme structure
 struct gs_command_proto
 {
@@ -408,8 +410,24 @@ struct gs_event_offsets
 
 struct gs_commands_container
 {
+    typedef ACE_Atomic_Op<ACE_Thread_Mutex, uint64> Counter;
+
     std::vector<gs_command*> command_vector;
     std::map<EventHookType, gs_event_offsets> event_offset_map;
+    // offset of the command executed after the one at given offset, when it does not jump;
+    // commands which only mark an offset (label, endif, ...) are never a successor
+    std::vector<uint32> next_offset;
+
+    // execution counters of all creatures running this script, only kept with GScript.Profiling;
+    // every creature adds its own counts in batches
+    Counter executed;       // commands executed
+    Counter exec_time;      // microseconds spent executing them
+
+    void RecordExecution(uint32 commands, uint32 time)
+    {
+        executed += commands;
+        exec_time += time;
+    }
 };
 
 // command structure
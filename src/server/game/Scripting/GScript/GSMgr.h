@@ -47,6 +47,7 @@ class GSMgr
         void RegisterAI(ScriptedAI* src);
         void UnregisterAI(ScriptedAI* src);
         CommandContainer* GetScript(int id);
+        std::map<int, CommandContainer*> const& GetLoadedScripts() const { return m_loadedScripts; }
 
         void AddError(int scriptId, std::string err);
         std::list<std::string>* GetErrorList();
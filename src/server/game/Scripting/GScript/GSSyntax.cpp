@@ -1712,6 +1712,37 @@ gs_command* gs_command::parse(gs_command_proto* src, int offset)
     return ret;
 }
 
+// true for commands, which have no effect when executed and exist only to mark a jump offset
+static bool gscr_isMarker(gs_command* cmd)
+{
+    switch (cmd->type)
+    {
+        case GSCR_LABEL:
+        case GSCR_ENDIF:
+        case GSCR_REPEAT:
+        case GSCR_ENDWHEN:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// resolves the successor of every command, so the interpreter does not spend an update on markers;
+// every jump lands on a marker or a block start and continues with its successor, so jumps are resolved as well
+static void gscr_linkSequence(CommandContainer* container)
+{
+    std::vector<gs_command*> const& commands = container->command_vector;
+    container->next_offset.resize(commands.size());
+
+    uint32 next = uint32(commands.size());
+    for (size_t i = commands.size(); i > 0; --i)
+    {
+        container->next_offset[i - 1] = next;
+        if (!gscr_isMarker(commands[i - 1]))
+            next = uint32(i - 1);
+    }
+}
+
 // analyzes sequence of command prototypes and parses lines of input to output CommandVector
 CommandContainer* gscr_analyseSequence(CommandProtoVector* input, int scriptId)
 {
@@ -1791,6 +1822,8 @@ CommandContainer* gscr_analyseSequence(CommandProtoVector* input, int scriptId)
             EventHookType ev_hook_type = gs_event_hook_names_map.at(event_command_pair.first);
             command_container->event_offset_map.insert({ ev_hook_type, event_command_pair.second });
         }
+
+        gscr_linkSequence(command_container);
     }
     catch (std::exception& e)
     {
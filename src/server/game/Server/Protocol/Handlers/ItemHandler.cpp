@@ -1092,7 +1092,7 @@ void WorldSession::SendListInventory(uint64 vendorguid)
                 if (leftInStock == 0)
                     continue;
 
-                ConditionList conditions = sConditionMgr->GetConditionsForNpcVendorEvent(pCreature->GetEntry(), vendorItem->item);
+                ConditionList const& conditions = sConditionMgr->GetConditionsForNpcVendorEvent(pCreature->GetEntry(), vendorItem->item);
                 if (!sConditionMgr->IsPlayerMeetToConditions(_player, conditions, pCreature))
                     continue;
             }
@@ -243,115 +243,121 @@ void WorldSession::HandleWhoOpcode(WorldPacket & recv_data)
     data << uint32(matchcount);                           // placeholder, count of players matching criteria
     data << uint32(displaycount);                         // placeholder, count of players displayed
 
-    ACE_GUARD(ACE_Thread_Mutex, g, *HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor->GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        if (security == SEC_PLAYER)
+    // /who walks one shard at a time, so logins and logouts in the other shards are not held up
+    std::vector<Player*> players;
+    for (uint32 shard = 0; shard < HashMapHolder<Player>::SHARD_COUNT; ++shard)
+    {
+        HashMapHolder<Player>::ShardReadGuard guard(shard);
+        players.clear();
+        sObjectAccessor->GetPlayers(players, guard);
+        for (std::vector<Player*>::const_iterator itr = players.begin(); itr != players.end(); ++itr)
         {
-            // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
-            if (itr->second->GetTeam() != team && !allowTwoSideWhoList)
-                continue;
+            if (security == SEC_PLAYER)
+            {
+                // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
+                if ((*itr)->GetTeam() != team && !allowTwoSideWhoList)
+                    continue;
 
-            // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
-            if ((itr->second->GetSession()->GetSecurity() > AccountTypes(gmLevelInWhoList)))
-                continue;
-        }
+                // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
+                if (((*itr)->GetSession()->GetSecurity() > AccountTypes(gmLevelInWhoList)))
+                    continue;
+            }
 
-        //do not process players which are not in world
-        if (!(itr->second->IsInWorld()))
-            continue;
+            //do not process players which are not in world
+            if (!((*itr)->IsInWorld()))
+                continue;
 
-        // check if target is globally visible for player
-        if (!(itr->second->IsVisibleGloballyFor(_player)))
-            continue;
+            // check if target is globally visible for player
+            if (!((*itr)->IsVisibleGloballyFor(_player)))
+                continue;
 
-        // check if target's level is in level range
-        uint8 lvl = itr->second->getLevel();
-        if (lvl < level_min || lvl > level_max)
-            continue;
+            // check if target's level is in level range
+            uint8 lvl = (*itr)->getLevel();
+            if (lvl < level_min || lvl > level_max)
+                continue;
 
-        // check if class matches classmask
-        uint32 class_ = itr->second->getClass();
-        if (!(classmask & (1 << class_)))
-            continue;
+            // check if class matches classmask
+            uint32 class_ = (*itr)->getClass();
+            if (!(classmask & (1 << class_)))
+                continue;
 
-        // check if race matches racemask
-        uint32 race = itr->second->getRace();
-        if (!(racemask & (1 << race)))
-            continue;
+            // check if race matches racemask
+            uint32 race = (*itr)->getRace();
+            if (!(racemask & (1 << race)))
+                continue;
 
-        uint32 pzoneid = itr->second->GetZoneId();
-        uint8 gender = itr->second->getGender();
+            uint32 pzoneid = (*itr)->GetZoneId();
+            uint8 gender = (*itr)->getGender();
 
-        bool z_show = true;
-        for (uint32 i = 0; i < zones_count; ++i)
-        {
-            if (zoneids[i] == pzoneid)
+            bool z_show = true;
+            for (uint32 i = 0; i < zones_count; ++i)
             {
-                z_show = true;
-                break;
-            }
+                if (zoneids[i] == pzoneid)
+                {
+                    z_show = true;
+                    break;
+                }
 
-            z_show = false;
-        }
-        if (!z_show)
-            continue;
+                z_show = false;
+            }
+            if (!z_show)
+                continue;
 
-        std::string pname = itr->second->GetName();
-        std::wstring wpname;
-        if (!Utf8toWStr(pname,wpname))
-            continue;
-        wstrToLower(wpname);
+            std::string pname = (*itr)->GetName();
+            std::wstring wpname;
+            if (!Utf8toWStr(pname,wpname))
+                continue;
+            wstrToLower(wpname);
 
-        if (!(wplayer_name.empty() || wpname.find(wplayer_name) != std::wstring::npos))
-            continue;
+            if (!(wplayer_name.empty() || wpname.find(wplayer_name) != std::wstring::npos))
+                continue;
 
-        std::string gname = sObjectMgr->GetGuildNameById(itr->second->GetGuildId());
-        std::wstring wgname;
-        if (!Utf8toWStr(gname,wgname))
-            continue;
-        wstrToLower(wgname);
+            std::string gname = sObjectMgr->GetGuildNameById((*itr)->GetGuildId());
+            std::wstring wgname;
+            if (!Utf8toWStr(gname,wgname))
+                continue;
+            wstrToLower(wgname);
 
-        if (!(wguild_name.empty() || wgname.find(wguild_name) != std::wstring::npos))
-            continue;
+            if (!(wguild_name.empty() || wgname.find(wguild_name) != std::wstring::npos))
+                continue;
 
-        std::string aname;
-        if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(itr->second->GetZoneId()))
-            aname = areaEntry->area_name;
+            std::string aname;
+            if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID((*itr)->GetZoneId()))
+                aname = areaEntry->area_name;
 
-        bool s_show = true;
-        for (uint32 i = 0; i < str_count; ++i)
-        {
-            if (!str[i].empty())
+            bool s_show = true;
+            for (uint32 i = 0; i < str_count; ++i)
             {
-                if (wgname.find(str[i]) != std::wstring::npos ||
-                    wpname.find(str[i]) != std::wstring::npos ||
-                    Utf8FitTo(aname, str[i]))
+                if (!str[i].empty())
                 {
-                    s_show = true;
-                    break;
+                    if (wgname.find(str[i]) != std::wstring::npos ||
+                        wpname.find(str[i]) != std::wstring::npos ||
+                        Utf8FitTo(aname, str[i]))
+                    {
+                        s_show = true;
+                        break;
+                    }
+                    s_show = false;
                 }
-                s_show = false;
             }
-        }
-        if (!s_show)
-            continue;
+            if (!s_show)
+                continue;
 
-        // 49 is maximum player count sent to client - can be overridden
-        // through config, but is unstable
-        if ((matchcount++) >= sWorld->getIntConfig(CONFIG_MAX_WHO))
-            continue;
+            // 49 is maximum player count sent to client - can be overridden
+            // through config, but is unstable
+            if ((matchcount++) >= sWorld->getIntConfig(CONFIG_MAX_WHO))
+                continue;
 
-        data << pname;                                    // player name
-        data << gname;                                    // guild name
-        data << uint32(lvl);                              // player level
-        data << uint32(class_);                           // player class
-        data << uint32(race);                             // player race
-        data << uint8(gender);                            // player gender
-        data << uint32(pzoneid);                          // player zone id
+            data << pname;                                    // player name
+            data << gname;                                    // guild name
+            data << uint32(lvl);                              // player level
+            data << uint32(class_);                           // player class
+            data << uint32(race);                             // player race
+            data << uint8(gender);                            // player gender
+            data << uint32(pzoneid);                          // player zone id
 
-        ++displaycount;
+            ++displaycount;
+        }
     }
 
     data.put(0, displaycount);                            // insert right count, count displayed
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://www.getmangos.com/>
+ *
+ * Copyright (C) 2008-2011 Trinity <http://www.trinitycore.org/>
+ *
+ * Copyright (C) 2010-2011 Project SkyFire <http://www.projectskyfire.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "gamePCH.h"
+/** \file
+    \ingroup u2w
+*/
+
+#include "OpcodeStats.h"
+#include "Opcodes.h"
+#include "Log.h"
+
+#include <ace/Guard_T.h>
+#include <ace/TSS_T.h>
+
+void OpcodeCounters::Add(OpcodeCounters const& right)
+{
+    sentCount += right.sentCount;
+    sentBytes += right.sentBytes;
+    compressedBytes += right.compressedBytes;
+    receivedCount += right.receivedCount;
+    receivedBytes += right.receivedBytes;
+    handledCount += right.handledCount;
+    handlerTime += right.handlerTime;
+}
+
+void OpcodeCounters::Subtract(OpcodeCounters const& right)
+{
+    sentCount -= right.sentCount;
+    sentBytes -= right.sentBytes;
+    compressedBytes -= right.compressedBytes;
+    receivedCount -= right.receivedCount;
+    receivedBytes -= right.receivedBytes;
+    handledCount -= right.handledCount;
+    handlerTime -= right.handlerTime;
+}
+
+// the table of the calling thread, created on its first counted packet
+struct OpcodeStatsThreadSlot
+{
+    OpcodeStatsThreadSlot() : pages(NULL) {}
+
+    OpcodeCounters** pages;
+};
+
+static ACE_TSS<OpcodeStatsThreadSlot> sThreadSlot;
+
+OpcodeStats::OpcodeStats() : m_resetBase(OPCODES_MAX), m_csvBase(OPCODES_MAX)
+{
+}
+
+OpcodeCounters* OpcodeStats::GetCounters(uint32 opcode)
+{
+    if (opcode >= OPCODES_MAX)
+        return NULL;
+
+    OpcodeStatsThreadSlot* slot = sThreadSlot.operator->();
+    if (!slot->pages)
+    {
+        ThreadTable* table = new ThreadTable();
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, NULL);
+        m_tables.push_back(table);
+        slot->pages = table->pages;
+    }
+
+    OpcodeCounters* page = slot->pages[opcode >> PAGE_BITS];
+    if (!page)
+    {
+        page = new OpcodeCounters[PAGE_SIZE];
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, NULL);
+        slot->pages[opcode >> PAGE_BITS] = page;
+    }
+
+    return &page[opcode & (PAGE_SIZE - 1)];
+}
+
+void OpcodeStats::RecordSent(uint32 opcode, size_t bytes)
+{
+    if (OpcodeCounters* counters = GetCounters(opcode))
+    {
+        ++counters->sentCount;
+        counters->sentBytes += bytes;
+    }
+}
+
+void OpcodeStats::RecordCompressed(uint32 opcode, size_t bytes)
+{
+    if (OpcodeCounters* counters = GetCounters(opcode))
+        counters->compressedBytes += bytes;
+}
+
+void OpcodeStats::RecordReceived(uint32 opcode, size_t bytes)
+{
+    if (OpcodeCounters* counters = GetCounters(opcode))
+    {
+        ++counters->receivedCount;
+        counters->receivedBytes += bytes;
+    }
+}
+
+void OpcodeStats::RecordHandler(uint32 opcode, uint32 time)
+{
+    if (OpcodeCounters* counters = GetCounters(opcode))
+    {
+        ++counters->handledCount;
+        counters->handlerTime += time;
+    }
+}
+
+// must be called with m_lock held; the owning threads keep counting meanwhile,
+// a counter read in the middle of an update only makes that one value a packet off
+void OpcodeStats::Collect(OpcodeCountersList& totals)
+{
+    totals.assign(OPCODES_MAX, OpcodeCounters());
+
+    for (std::vector<ThreadTable*>::const_iterator itr = m_tables.begin(); itr != m_tables.end(); ++itr)
+        for (uint32 page = 0; page < PAGE_COUNT; ++page)
+            if (OpcodeCounters const* counters = (*itr)->pages[page])
+                for (uint32 i = 0; i < PAGE_SIZE; ++i)
+                    totals[(page << PAGE_BITS) + i].Add(counters[i]);
+}
+
+void OpcodeStats::GetTotals(OpcodeCountersList& totals)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    Collect(totals);
+    for (uint32 i = 0; i < OPCODES_MAX; ++i)
+        totals[i].Subtract(m_resetBase[i]);
+}
+
+void OpcodeStats::Reset()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    Collect(m_resetBase);
+}
+
+void OpcodeStats::DumpCSV()
+{
+    if (m_csvFile.empty())
+        return;
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    OpcodeCountersList totals;
+    Collect(totals);
+
+    FILE* file = fopen(m_csvFile.c_str(), "a");
+    if (!file)
+    {
+        sLog->outError("OpcodeStats: can't open %s for writing.", m_csvFile.c_str());
+        return;
+    }
+
+    // header line for a new file
+    fseek(file, 0, SEEK_END);
+    if (ftell(file) == 0)
+        fprintf(file, "time,opcode,name,sent_count,sent_bytes,compressed_bytes,received_count,received_bytes,handled_count,handler_time_us\n");
+
+    uint64 now = uint64(time(NULL));
+    for (uint32 i = 0; i < OPCODES_MAX; ++i)
+    {
+        OpcodeCounters counters = totals[i];
+        counters.Subtract(m_csvBase[i]);
+        if (counters.IsEmpty())
+            continue;
+
+        fprintf(file, UI64FMTD ",0x%04X,%s," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "\n",
+            now, i, LookupOpcodeName(i), counters.sentCount, counters.sentBytes, counters.compressedBytes,
+            counters.receivedCount, counters.receivedBytes, counters.handledCount, counters.handlerTime);
+    }
+
+    fclose(file);
+    m_csvBase.swap(totals);
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://www.getmangos.com/>
+ *
+ * Copyright (C) 2008-2011 Trinity <http://www.trinitycore.org/>
+ *
+ * Copyright (C) 2010-2011 Project SkyFire <http://www.projectskyfire.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/// \addtogroup u2w
+/// @{
+/// \file
+
+#ifndef TRINITY_OPCODESTATS_H
+#define TRINITY_OPCODESTATS_H
+
+#include "Common.h"
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+
+struct OpcodeCounters
+{
+    OpcodeCounters() : sentCount(0), sentBytes(0), compressedBytes(0), receivedCount(0), receivedBytes(0),
+        handledCount(0), handlerTime(0) {}
+
+    void Add(OpcodeCounters const& right);
+    void Subtract(OpcodeCounters const& right);
+    bool IsEmpty() const { return !sentCount && !receivedCount && !handledCount; }
+
+    uint64 sentCount;
+    uint64 sentBytes;                                       // payload before compression
+    uint64 compressedBytes;                                 // payload of the packets sent compressed, after compression
+    uint64 receivedCount;
+    uint64 receivedBytes;
+    uint64 handledCount;
+    uint64 handlerTime;                                     // microseconds spent in the opcode handler
+};
+
+typedef std::vector<OpcodeCounters> OpcodeCountersList;    // indexed by opcode, OPCODES_MAX entries
+
+/// Per opcode network counters. Every thread counts into its own table without locking,
+/// the tables are only merged when the statistics are requested.
+class OpcodeStats
+{
+    friend class ACE_Singleton<OpcodeStats, ACE_Thread_Mutex>;
+    OpcodeStats();
+    OpcodeStats(OpcodeStats const&);
+    OpcodeStats& operator=(OpcodeStats const&);
+
+    public:
+        void RecordSent(uint32 opcode, size_t bytes);
+        void RecordCompressed(uint32 opcode, size_t bytes);
+        void RecordReceived(uint32 opcode, size_t bytes);
+        void RecordHandler(uint32 opcode, uint32 time);
+
+        /// Counters of all threads since the last Reset()
+        void GetTotals(OpcodeCountersList& totals);
+        void Reset();
+
+        /// Appends the counters since the previous dump to the CSV file, if one is configured
+        void DumpCSV();
+        void SetCSVFile(std::string const& filename) { m_csvFile = filename; }
+        bool HasCSVFile() const { return !m_csvFile.empty(); }
+
+    private:
+        // Opcodes are split in pages allocated the first time a thread counts one of them,
+        // the page table of a thread is only changed under m_lock.
+        enum
+        {
+            PAGE_BITS = 8,
+            PAGE_SIZE = 1 << PAGE_BITS,
+            PAGE_COUNT = 0x10000 >> PAGE_BITS
+        };
+
+        struct ThreadTable
+        {
+            ThreadTable() { memset(pages, 0, sizeof(pages)); }
+
+            OpcodeCounters* pages[PAGE_COUNT];
+        };
+
+        OpcodeCounters* GetCounters(uint32 opcode);
+        void Collect(OpcodeCountersList& totals);
+
+        ACE_Thread_Mutex m_lock;
+        std::vector<ThreadTable*> m_tables;                 // never freed, a thread keeps its table until shutdown
+        OpcodeCountersList m_resetBase;                     // totals at the last Reset()
+        OpcodeCountersList m_csvBase;                       // totals at the last DumpCSV()
+        std::string m_csvFile;
+};
+
+#define sOpcodeStats ACE_Singleton<OpcodeStats, ACE_Thread_Mutex>::instance()
+#endif
+/// @}
@@ -20,15 +20,23 @@
 #include "Opcodes.h"
 #include <zlib.h>
 
-WorldPacket::WorldPacket() : ByteBuffer(0), m_opcode(0), m_realOpcode(0)
+#include <ace/Message_Block.h>
+#include <ace/Lock_Adapter_T.h>
+#include <ace/Thread_Mutex.h>
+
+// shared contents are released by the network threads while the map threads still duplicate them
+static ACE_Lock_Adapter<ACE_Thread_Mutex> sSharedContentsLock;
+
+WorldPacket::WorldPacket() : ByteBuffer(0), m_opcode(0), m_realOpcode(0), m_broadcasts(0), m_sharedContents(NULL)
 {
 }
 
-WorldPacket::WorldPacket(const WorldPacket &packet) : ByteBuffer(packet), m_opcode(packet.m_opcode), m_realOpcode(packet.m_realOpcode)
+WorldPacket::WorldPacket(const WorldPacket &packet) : ByteBuffer(packet), m_opcode(packet.m_opcode), m_realOpcode(packet.m_realOpcode),
+m_broadcasts(0), m_sharedContents(NULL)
 {
 }
 
-WorldPacket::WorldPacket(uint32 opcode, size_t res, bool hack) : ByteBuffer(res), m_opcode(opcode)
+WorldPacket::WorldPacket(uint32 opcode, size_t res, bool hack) : ByteBuffer(res), m_opcode(opcode), m_broadcasts(0), m_sharedContents(NULL)
 {
     // This is a hack fix.
     // The client will not 'eat' certain opcodes when they're sent under normal circumstances.
@@ -45,6 +53,58 @@ WorldPacket::WorldPacket(uint32 opcode, size_t res, bool hack) : ByteBuffer(res)
     m_realOpcode = opcode;
 }
 
+WorldPacket& WorldPacket::operator=(const WorldPacket &packet)
+{
+    if (this != &packet)
+    {
+        ByteBuffer::operator=(packet);
+        m_opcode = packet.m_opcode;
+        m_realOpcode = packet.m_realOpcode;
+
+        if (m_sharedContents)
+        {
+            m_sharedContents->release();
+            m_sharedContents = NULL;
+        }
+    }
+    return *this;
+}
+
+WorldPacket::~WorldPacket()
+{
+    if (m_sharedContents)
+        m_sharedContents->release();
+}
+
+ACE_Message_Block* WorldPacket::DuplicateContents() const
+{
+    if (m_sharedContents)
+        return m_sharedContents->duplicate();
+
+    ACE_Message_Block* block = new ACE_Message_Block(size(), ACE_Message_Block::MB_DATA, NULL, NULL, NULL,
+        m_broadcasts ? &sSharedContentsLock : NULL);
+    if (!empty())
+        block->copy((char const*)contents(), size());
+
+    if (!m_broadcasts)
+        return block;
+
+    m_sharedContents = block;
+    return block->duplicate();
+}
+
+void WorldPacket::EndBroadcast() const
+{
+    if (!m_broadcasts || --m_broadcasts)
+        return;
+
+    if (m_sharedContents)
+    {
+        m_sharedContents->release();
+        m_sharedContents = NULL;
+    }
+}
+
 void WorldPacket::Initialize(uint32 opcode, size_t newres, bool hack)
 {
     clear();
@@ -96,7 +156,12 @@ void WorldPacket::Compress(z_stream* compressionStream, WorldPacket const* sourc
 {
     ASSERT(source != this);
 
-    uint16 uncompressedOpcode = source->GetOpcode();
+    Compress(compressionStream, source->GetOpcode(), source->contents(), uint32(source->size()));
+}
+
+//! Compresses packet contents and stores them in self
+void WorldPacket::Compress(z_stream* compressionStream, uint32 uncompressedOpcode, uint8 const* source, uint32 size)
+{
     if (uncompressedOpcode & COMPRESSED_OPCODE_MASK)
     {
         sLog->outError("Packet with opcode 0x%04X is already compressed!", uncompressedOpcode);
@@ -104,14 +169,13 @@ void WorldPacket::Compress(z_stream* compressionStream, WorldPacket const* sourc
     }
 
     uint16 opcode = uint16(uncompressedOpcode | COMPRESSED_OPCODE_MASK);
-    uint32 size = source->size();
     uint32 destsize = compressBound(size);
 
     size_t sizePos = 0;
     resize(destsize + sizeof(uint32));
 
     _compressionStream = compressionStream;
-    Compress(static_cast<void*>(&_storage[0] + sizeof(uint32)), &destsize, static_cast<const void*>(source->contents()), size);
+    Compress(static_cast<void*>(&_storage[0] + sizeof(uint32)), &destsize, static_cast<const void*>(source), size);
     if (destsize == 0)
         return;
 
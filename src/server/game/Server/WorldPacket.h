@@ -27,6 +27,7 @@
 #include "ByteBuffer.h"
 
 struct z_stream_s;
+class ACE_Message_Block;
 
 class WorldPacket : public ByteBuffer
 {
@@ -37,6 +38,8 @@ class WorldPacket : public ByteBuffer
 
         // copy constructor
         WorldPacket(const WorldPacket &packet);
+        WorldPacket& operator=(const WorldPacket &packet);
+        ~WorldPacket();
 
         void Initialize(uint32 opcode, size_t newres = 200, bool hack = false);
 
@@ -48,6 +51,13 @@ class WorldPacket : public ByteBuffer
         void Compress(uint32 opcode);
         void Compress(z_stream_s* compressionStream);
         void Compress(z_stream_s* compressionStream, WorldPacket const* source);
+        void Compress(z_stream_s* compressionStream, uint32 opcode, uint8 const* source, uint32 size);
+
+        // Contents for a socket output queue, the caller releases the block. While the packet is
+        // broadcast all queues share one reference counted copy, it must not be changed meanwhile.
+        ACE_Message_Block* DuplicateContents() const;
+        void BeginBroadcast() const { ++m_broadcasts; }
+        void EndBroadcast() const;
 
     protected:
 
@@ -57,6 +67,25 @@ class WorldPacket : public ByteBuffer
         void Compress(void* dst, uint32 *dst_size, const void* src, int src_size);
 
         z_stream_s* _compressionStream;
+
+    private:
+
+        mutable uint32 m_broadcasts;
+        mutable ACE_Message_Block* m_sharedContents;
+};
+
+// Shares the contents of a packet sent to many sessions for the lifetime of the object
+class WorldPacketBroadcast
+{
+    public:
+        explicit WorldPacketBroadcast(WorldPacket const* packet) : m_packet(packet) { m_packet->BeginBroadcast(); }
+        WorldPacketBroadcast(WorldPacketBroadcast const& right) : m_packet(right.m_packet) { m_packet->BeginBroadcast(); }
+        ~WorldPacketBroadcast() { m_packet->EndBroadcast(); }
+
+    private:
+        WorldPacketBroadcast& operator=(WorldPacketBroadcast const&);
+
+        WorldPacket const* m_packet;
 };
 #endif
 
@@ -46,6 +46,9 @@
 #include "SocialMgr.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
+#include "OpcodeStats.h"
+
+#include <ace/OS_NS_sys_time.h>
 
 /// WorldSession constructor
 WorldSession::WorldSession(uint32 id, WorldSocket *sock, AccountTypes sec, uint8 expansion, time_t mute_time, LocaleConstant locale, uint32 recruiter):
@@ -64,19 +67,6 @@ m_latency(0), m_TutorialsChanged(false), recruiterId(recruiter)
         ResetTimeOutTime();
         LoginDatabase.PExecute("UPDATE account SET online = '%u' WHERE id = %u;", realmID, GetAccountId());
     }
-
-    _compressionStream = new z_stream();
-    _compressionStream->zalloc = (alloc_func)NULL;
-    _compressionStream->zfree = (free_func)NULL;
-    _compressionStream->opaque = (voidpf)NULL;
-    _compressionStream->avail_in = 0;
-    _compressionStream->next_in = NULL;
-    int32 z_res = deflateInit(_compressionStream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
-    {
-        sLog->outError("Can't initialize packet compression (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
-        return;
-    }
 }
 
 /// WorldSession destructor
@@ -100,15 +90,6 @@ WorldSession::~WorldSession()
         delete packet;
 
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());
-
-    int32 z_res = deflateEnd(_compressionStream);
-    if (z_res != Z_OK && z_res != Z_DATA_ERROR) // Z_DATA_ERROR signals that internal state was BUSY
-    {
-        sLog->outError("Can't close packet compression stream (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        return;
-    }
-
-    delete _compressionStream;
 }
 
 void WorldSession::SizeError(WorldPacket const& packet, uint32 size) const
@@ -220,6 +201,16 @@ void WorldSession::LogUnprocessedTail(WorldPacket *packet)
         packet->print_storage();
 }
 
+void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet)
+{
+    ACE_Time_Value start = ACE_OS::gettimeofday();
+
+    (this->*opHandle.handler)(packet);
+
+    ACE_Time_Value diff = ACE_OS::gettimeofday() - start;
+    sOpcodeStats->RecordHandler(packet.GetOpcode(), uint32(diff.sec() * 1000000 + diff.usec()));
+}
+
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(uint32 diff)
 {
@@ -281,7 +272,7 @@ bool WorldSession::Update(uint32 diff)
                             else if (_player->IsInWorld())
                             {
                                 sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                                (this->*opHandle->handler)(*packet);
+                                ExecuteOpcode(*opHandle, *packet);
                                 if (sLog->IsOutDebug() && packet->rpos() < packet->wpos())
                                     LogUnprocessedTail(packet);
                             }
@@ -296,7 +287,7 @@ bool WorldSession::Update(uint32 diff)
                             {
                                 // not expected _player or must checked in packet hanlder
                                 sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                                (this->*opHandle->handler)(*packet);
+                                ExecuteOpcode(*opHandle, *packet);
                                 if (sLog->IsOutDebug() && packet->rpos() < packet->wpos())
                                     LogUnprocessedTail(packet);
                             }
@@ -309,7 +300,7 @@ bool WorldSession::Update(uint32 diff)
                             else
                             {
                                 sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                                (this->*opHandle->handler)(*packet);
+                                ExecuteOpcode(*opHandle, *packet);
                                 if (sLog->IsOutDebug() && packet->rpos() < packet->wpos())
                                     LogUnprocessedTail(packet);
                             }
@@ -328,7 +319,7 @@ bool WorldSession::Update(uint32 diff)
                                 m_playerRecentlyLogout = false;
 
                             sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                            (this->*opHandle->handler)(*packet);
+                            ExecuteOpcode(*opHandle, *packet);
                             if (sLog->IsOutDebug() && packet->rpos() < packet->wpos())
                                 LogUnprocessedTail(packet);
                             break;
@@ -61,6 +61,7 @@ struct LfgProposal;
 struct LfgReward;
 struct LfgRoleCheck;
 struct LfgUpdateData;
+struct OpcodeHandler;
 
 
 enum AccountDataType
@@ -348,8 +349,6 @@ class WorldSession
         // Recruit-A-Friend Handling
         uint32 GetRecruiterId() { return recruiterId; }
 
-        z_stream_s* GetCompressionStream() { return _compressionStream; }
-
     public:                                                 // opcodes handlers
 
         void Handle_NULL(WorldPacket& recvPacket);          // not used
@@ -938,6 +937,9 @@ class WorldSession
         void LogUnexpectedOpcode(WorldPacket *packet, const char * reason);
         void LogUnprocessedTail(WorldPacket *packet);
 
+        // calls the opcode handler and counts the time spent in it
+        void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet);
+
         bool CharCanLogin(uint32 lowGUID)
         {
             return _allowedCharsToLogin.find(lowGUID) != _allowedCharsToLogin.end();
@@ -968,7 +970,6 @@ class WorldSession
         AddonsList m_addonsList;
         uint32 recruiterId;
         ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
-        z_stream_s* _compressionStream;
 };
 #endif
 /// @}
@@ -48,8 +48,11 @@
 #include "WorldSocketMgr.h"
 #include "Log.h"
 #include "WorldLog.h"
+#include "OpcodeStats.h"
 #include "ScriptMgr.h"
 
+#include <zlib.h>
+
 #if defined(__GNUC__)
 #pragma pack(1)
 #else
@@ -91,6 +94,14 @@ struct ServerPktHeader
     uint8 header[5];
 };
 
+// head of a packet in the output queue, the packet contents follow in its continuation block
+struct QueuedPktHeader
+{
+    uint32 opcode;
+    uint32 realOpcode;
+    bool compress;
+};
+
 struct ClientPktHeader
 {
     uint16 size;
@@ -106,13 +117,27 @@ struct ClientPktHeader
 WorldSocket::WorldSocket (void): WorldHandler(),
 m_LastPingTime(ACE_Time_Value::zero), m_OverSpeedPings(0), m_Session(0),
 m_RecvWPct(0), m_RecvPct(), m_Header(sizeof (ClientPktHeader)),
-m_OutBuffer(0), m_OutBufferSize(65536), m_OutActive(false),
+m_OutBuffer(0), m_OutBufferSize(65536), m_OutActive(false), m_CompressionStream(NULL),
 m_Seed(static_cast<uint32> (rand32()))
 {
     reference_counting_policy().value (ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
 
     msg_queue()->high_water_mark(8 * 1024 * 1024);
     msg_queue()->low_water_mark(8 * 1024 * 1024);
+
+    m_CompressionStream = new z_stream();
+    m_CompressionStream->zalloc = (alloc_func)NULL;
+    m_CompressionStream->zfree = (free_func)NULL;
+    m_CompressionStream->opaque = (voidpf)NULL;
+    m_CompressionStream->avail_in = 0;
+    m_CompressionStream->next_in = NULL;
+    int32 z_res = deflateInit(m_CompressionStream, sWorld->getIntConfig(CONFIG_COMPRESSION));
+    if (z_res != Z_OK)
+    {
+        sLog->outError("Can't initialize packet compression (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+        delete m_CompressionStream;
+        m_CompressionStream = NULL;
+    }
 }
 
 WorldSocket::~WorldSocket (void)
@@ -122,6 +147,15 @@ WorldSocket::~WorldSocket (void)
     if (m_OutBuffer)
         m_OutBuffer->release();
 
+    if (m_CompressionStream)
+    {
+        int32 z_res = deflateEnd(m_CompressionStream);
+        if (z_res != Z_OK && z_res != Z_DATA_ERROR) // Z_DATA_ERROR signals that internal state was BUSY
+            sLog->outError("Can't close packet compression stream (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
+
+        delete m_CompressionStream;
+    }
+
     closing_ = true;
 
     peer().close();
@@ -194,52 +228,94 @@ int WorldSocket::SendPacket (const WorldPacket& pct)
         return 0;
     }
 
-    WorldPacket const* pkt = &pct;
+    sScriptMgr->OnPacketSend(this, pct);
+    sOpcodeStats->RecordSent(pct.GetRealOpcode(), pct.size());
 
-    // Empty buffer used in case packet should be compressed
-    WorldPacket buff;
-    if (m_Session && pkt->size() > 0x400)
+    // Large packets are compressed when they are taken from the queue, whatever is sent after them has to
+    // be queued as well to keep the order of the encrypted headers.
+    bool compress = m_Session && m_CompressionStream && pct.size() > 0x400;
+
+    if (!compress && msg_queue()->is_empty())
     {
-        buff.Compress(m_Session->GetCompressionStream(), pkt);
-        pkt = &buff;
-    }
+        ServerPktHeader header(pct.size()+2, pct.GetOpcode());
 
-    sScriptMgr->OnPacketSend(this, *pkt);
+        if (m_OutBuffer->space() >= pct.size() + header.getHeaderLength())
+        {
+            m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
 
-    ServerPktHeader header(pkt->size()+2, pkt->GetOpcode());
-    m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
+            // Put the packet on the buffer.
+            if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
+                ACE_ASSERT (false);
 
-    if (m_OutBuffer->space() >= pkt->size() + header.getHeaderLength() && msg_queue()->is_empty())
-    {
-        // Put the packet on the buffer.
-        if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
-            ACE_ASSERT (false);
+            if (!pct.empty())
+                if (m_OutBuffer->copy((char*)pct.contents(), pct.size()) == -1)
+                    ACE_ASSERT (false);
 
-        if (!pkt->empty())
-            if (m_OutBuffer->copy((char*)pkt->contents(), pkt->size()) == -1)
-                ACE_ASSERT (false);
+            return 0;
+        }
     }
-    else
+
+    // Enqueue the packet, it refers to the packet contents shared with the other recipients of a broadcast.
+    ACE_Message_Block* mb;
+
+    ACE_NEW_RETURN(mb, ACE_Message_Block(sizeof(QueuedPktHeader), ACE_Message_Block::MB_USER), -1);
+
+    QueuedPktHeader queued;
+    queued.opcode = pct.GetOpcode();
+    queued.realOpcode = pct.GetRealOpcode();
+    queued.compress = compress;
+    mb->copy((const char*)&queued, sizeof(queued));
+    mb->cont(pct.DuplicateContents());
+
+    if (msg_queue()->enqueue_tail(mb,(ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
     {
-        // Enqueue the packet.
-        ACE_Message_Block* mb;
+        sLog->outError("WorldSocket::SendPacket enqueue_tail failed");
+        mb->release();
+        return -1;
+    }
 
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pkt->size() + header.getHeaderLength()), -1);
+    return 0;
+}
 
-        mb->copy((char*) header.header, header.getHeaderLength());
+ACE_Message_Block* WorldSocket::finish_queued_packet (ACE_Message_Block const* queued)
+{
+    QueuedPktHeader info;
+    memcpy(&info, queued->rd_ptr(), sizeof(info));
 
-        if (!pkt->empty())
-            mb->copy((const char*)pkt->contents(), pkt->size());
+    ACE_Message_Block const* contents = queued->cont();
+    uint32 opcode = info.opcode;
+    const uint8* data = (const uint8*)contents->rd_ptr();
+    uint32 size = uint32(contents->length());
 
-        if (msg_queue()->enqueue_tail(mb,(ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+    // Empty buffer used in case packet should be compressed
+    WorldPacket buff;
+    if (info.compress)
+    {
+        buff.Compress(m_CompressionStream, opcode, data, size);
+
+        // send it uncompressed if zlib failed
+        if (buff.GetOpcode() & COMPRESSED_OPCODE_MASK)
         {
-            sLog->outError("WorldSocket::SendPacket enqueue_tail failed");
-            mb->release();
-            return -1;
+            opcode = buff.GetOpcode();
+            data = buff.contents();
+            size = uint32(buff.size());
+            sOpcodeStats->RecordCompressed(info.realOpcode, size);
         }
     }
 
-    return 0;
+    ServerPktHeader header(size+2, opcode);
+    m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
+
+    ACE_Message_Block* mb;
+
+    ACE_NEW_RETURN(mb, ACE_Message_Block(size + header.getHeaderLength()), NULL);
+
+    mb->copy((char*) header.header, header.getHeaderLength());
+
+    if (size)
+        mb->copy((const char*)data, size);
+
+    return mb;
 }
 
 long WorldSocket::AddReference (void)
@@ -419,6 +495,18 @@ int WorldSocket::handle_output_queue (GuardType& g)
         return -1;
     }
 
+    // packets are queued unencrypted, the partially sent rest of one is put back finished
+    if (mblk->msg_type() == ACE_Message_Block::MB_USER)
+    {
+        ACE_Message_Block* packet = finish_queued_packet(mblk);
+        mblk->release();
+
+        if (!packet)
+            return -1;
+
+        mblk = packet;
+    }
+
     const size_t send_len = mblk->length();
 
 #ifdef MSG_NOSIGNAL
@@ -714,6 +802,8 @@ int WorldSocket::ProcessIncoming (WorldPacket* new_pct)
     if (closing_)
         return -1;
 
+    sOpcodeStats->RecordReceived(opcode, new_pct->size());
+
     // Dump received packet.
     if (sWorldLog->LogWorld())
     {
@@ -50,6 +50,7 @@
 class ACE_Message_Block;
 class WorldPacket;
 class WorldSession;
+struct z_stream_s;
 
 /// Handler that can communicate over stream sockets.
 typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
@@ -75,6 +76,12 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  * sending packets from "producer" threads is minimal,
  * and doing a lot of writes with small size is tolerated.
  *
+ * Packets which do not fit the buffer or have to be compressed
+ * are queued with a reference to their contents, shared between
+ * all sockets while a packet is broadcast. Their headers are
+ * encrypted and large ones compressed when they are taken from
+ * the queue, on the network thread instead of the sender's.
+ *
  * The calls to Update() method are managed by WorldSocketMgr
  * and ReactorRunnable.
  *
@@ -163,6 +170,9 @@ class WorldSocket : protected WorldHandler
         /// Drain the queue if its not empty.
         int handle_output_queue (GuardType& g);
 
+        /// Builds the block sent for a packet queued by SendPacket, compressing and encrypting it.
+        ACE_Message_Block* finish_queued_packet (ACE_Message_Block const* queued);
+
         /// process one incoming packet.
         /// @param new_pct received packet ,note that you need to delete it.
         int ProcessIncoming (WorldPacket* new_pct);
@@ -215,6 +225,9 @@ class WorldSocket : protected WorldHandler
         /// True if the socket is registered with the reactor for output
         bool m_OutActive;
 
+        /// zlib stream of the packets compressed for this connection, the client keeps its state.
+        z_stream_s* m_CompressionStream;
+
         uint32 m_Seed;
 
 };
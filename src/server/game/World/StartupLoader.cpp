@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://www.getmangos.com/>
+ *
+ * Copyright (C) 2008-2011 Trinity <http://www.trinitycore.org/>
+ *
+ * Copyright (C) 2010-2011 Project SkyFire <http://www.projectskyfire.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "gamePCH.h"
+#include "StartupLoader.h"
+#include "DatabaseEnv.h"
+#include "Timer.h"
+
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+
+StartupLoader::StartupLoader() : m_mutex(), m_condition(m_mutex), m_unfinished(0), m_runStart(0), m_runTime(0), m_threads(0)
+{
+}
+
+uint32 StartupLoader::Add(char const* name, LoadFunction const& function)
+{
+    m_tasks.push_back(Task(name, function));
+    return uint32(m_tasks.size() - 1);
+}
+
+uint32 StartupLoader::Add(char const* name, LoadFunction const& function, uint32 after)
+{
+    uint32 task = Add(name, function);
+    AddDependency(task, after);
+    return task;
+}
+
+void StartupLoader::AddDependency(uint32 task, uint32 after)
+{
+    ASSERT(after < task && task < m_tasks.size());
+
+    m_tasks[after].dependents.push_back(task);
+    ++m_tasks[task].waiting;
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    m_runStart = getMSTime();
+    m_threads = std::min<uint32>(std::max<uint32>(threads, 1), uint32(m_tasks.size()));
+
+    m_ready.clear();
+    m_unfinished = uint32(m_tasks.size());
+    for (uint32 i = 0; i < m_tasks.size(); ++i)
+        if (!m_tasks[i].waiting)
+            m_ready.push_back(i);
+
+    // first added is first started, this keeps the order of the sequential run
+    std::reverse(m_ready.begin(), m_ready.end());
+
+    bool done = false;
+    if (m_threads > 1)
+    {
+        if (activate(THR_NEW_LWP | THR_JOINABLE, int(m_threads)) != -1)
+        {
+            wait();
+            done = true;
+        }
+        else
+            sLog->outError("StartupLoader: could not start %u threads, loading sequentially.", m_threads);
+    }
+
+    if (!done)
+    {
+        m_threads = 1;
+        svc();
+    }
+
+    m_runTime = getMSTimeDiff(m_runStart, getMSTime());
+}
+
+int StartupLoader::svc()
+{
+    bool ownThread = m_threads > 1;
+    if (ownThread)
+        MySQL::Thread_Init();
+
+    for (;;)
+    {
+        uint32 index;
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+            while (m_ready.empty() && m_unfinished)
+                m_condition.wait();
+
+            if (m_ready.empty())
+                break;
+
+            index = m_ready.back();
+            m_ready.pop_back();
+        }
+
+        Task& task = m_tasks[index];
+        RunTask(task);
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+        for (std::vector<uint32>::const_iterator itr = task.dependents.begin(); itr != task.dependents.end(); ++itr)
+            if (!--m_tasks[*itr].waiting)
+                m_ready.push_back(*itr);
+
+        --m_unfinished;
+        m_condition.broadcast();
+    }
+
+    if (ownThread)
+        MySQL::Thread_End();
+
+    return 0;
+}
+
+void StartupLoader::RunTask(Task& task)
+{
+    uint32 start = getMSTime();
+    task.started = getMSTimeDiff(m_runStart, start);
+    task.function();
+    task.duration = getMSTimeDiff(start, getMSTime());
+}
+
+void StartupLoader::PrintReport() const
+{
+    std::vector<Task const*> tasks;
+    uint32 total = 0;
+    for (std::vector<Task>::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+    {
+        tasks.push_back(&*itr);
+        total += itr->duration;
+    }
+
+    struct LongerTask
+    {
+        bool operator()(Task const* a, Task const* b) const { return a->duration > b->duration; }
+    };
+    std::stable_sort(tasks.begin(), tasks.end(), LongerTask());
+
+    sLog->outString("Startup loaders: %u tasks on %u threads, %u ms (%u ms if run one after another)",
+        uint32(m_tasks.size()), m_threads, m_runTime, total);
+    for (std::vector<Task const*>::const_iterator itr = tasks.begin(); itr != tasks.end(); ++itr)
+        sLog->outString("    %-40s %6u ms (started at %u ms)", (*itr)->name.c_str(), (*itr)->duration, (*itr)->started);
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://www.getmangos.com/>
+ *
+ * Copyright (C) 2008-2011 Trinity <http://www.trinitycore.org/>
+ *
+ * Copyright (C) 2010-2011 Project SkyFire <http://www.projectskyfire.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef _STARTUP_LOADER_H_INCLUDED
+#define _STARTUP_LOADER_H_INCLUDED
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include "Define.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+ * Runs a group of world startup loaders as a dependency graph. A loader is started as soon as
+ * all loaders it depends on have finished, so independent ones run on several threads at once.
+ * Loaders use the database pools as usual: synchronous queries take a free synch connection,
+ * WorldDatabase.SynchThreads and CharacterDatabase.SynchThreads limit how many really run in parallel.
+ * Only loaders which do not touch each other's data may be added without a dependency.
+ */
+class StartupLoader : protected ACE_Task_Base
+{
+    public:
+
+        typedef std::function<void()> LoadFunction;
+
+        StartupLoader();
+        virtual ~StartupLoader() {}
+
+        // dependencies must have been added before the task depending on them
+        uint32 Add(char const* name, LoadFunction const& function);
+        uint32 Add(char const* name, LoadFunction const& function, uint32 after);
+        void AddDependency(uint32 task, uint32 after);
+
+        // runs all tasks and returns once they have finished, threads <= 1 runs them in the order added
+        void Run(uint32 threads);
+
+        // prints the time spent in every task, longest first
+        void PrintReport() const;
+
+        virtual int svc();
+
+    private:
+
+        struct Task
+        {
+            Task(char const* n, LoadFunction const& f) : name(n), function(f), waiting(0), started(0), duration(0) {}
+
+            std::string name;
+            LoadFunction function;
+            std::vector<uint32> dependents;                 // tasks waiting for this one
+            uint32 waiting;                                 // unfinished dependencies, guarded by m_mutex
+            uint32 started;                                 // ms since Run()
+            uint32 duration;                                // ms
+        };
+
+        void RunTask(Task& task);
+
+        std::vector<Task> m_tasks;
+        std::vector<uint32> m_ready;                        // tasks with no unfinished dependency
+
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+        uint32 m_unfinished;
+        uint32 m_runStart;
+        uint32 m_runTime;
+        uint32 m_threads;
+};
+
+#endif
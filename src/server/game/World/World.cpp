@@ -72,6 +72,8 @@
 #include "TransportMgr.h"
 #include "GSMgr.h"
 #include "QueryScheduler.h"
+#include "StartupLoader.h"
+#include "OpcodeStats.h"
 
 #include "ScriptMgr.h"
 #include "AddonMgr.h"
@@ -1223,10 +1225,14 @@ void World::LoadConfigSettings(bool reload)
     {
         m_dataPath = dataPath;
         sLog->outString("Using DataDir %s",m_dataPath.c_str());
+
+        // only used while loading the data stores
+        DBCFileLoader::SetMappingEnabled(sConfig->GetBoolDefault("DBC.MapFiles", false));
     }
 
     m_bool_configs[CONFIG_VMAP_INDOOR_CHECK] = sConfig->GetBoolDefault("vmap.enableIndoorCheck", 0);
     m_bool_configs[CONFIG_ENABLE_MMAPS] = sConfig->GetBoolDefault("mmap.enablePathFinding", false);
+    m_bool_configs[CONFIG_TERRAIN_MEMORY_MAP] = sConfig->GetBoolDefault("Terrain.MemoryMap", true);
     bool enableLOS = sConfig->GetBoolDefault("vmap.enableLOS", true);
     bool enableHeight = sConfig->GetBoolDefault("vmap.enableHeight", true);
     std::string ignoreMapIds = sConfig->GetStringDefault("vmap.ignoreMapIds", "");
@@ -1261,6 +1267,8 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfig->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = sConfig->GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = sConfig->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = sConfig->GetIntDefault("Startup.LoaderThreads", 1);
+    m_bool_configs[CONFIG_MAP_UPDATE_REGIONS] = sConfig->GetBoolDefault("MapUpdate.Regions", false);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfig->GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1285,6 +1293,22 @@ void World::LoadConfigSettings(bool reload)
     // MySQL ping time interval
     m_int_configs[CONFIG_DB_PING_INTERVAL] = sConfig->GetIntDefault("MaxPingTime", 30);
 
+    m_int_configs[CONFIG_OPCODE_STATS_INTERVAL] = sConfig->GetIntDefault("OpcodeStatsInterval", 300);
+    if (m_int_configs[CONFIG_OPCODE_STATS_INTERVAL] == 0)
+        m_int_configs[CONFIG_OPCODE_STATS_INTERVAL] = 300;
+
+    std::string opcodeStatsFile = sConfig->GetStringDefault("OpcodeStatsFile", "");
+    if (!opcodeStatsFile.empty())
+    {
+        std::string logsDir = sConfig->GetStringDefault("LogsDir", "");
+        if (!logsDir.empty() && logsDir.at(logsDir.length() - 1) != '/' && logsDir.at(logsDir.length() - 1) != '\\')
+            logsDir.append("/");
+        opcodeStatsFile = logsDir + opcodeStatsFile;
+    }
+    sOpcodeStats->SetCSVFile(opcodeStatsFile);
+
+    m_bool_configs[CONFIG_GSCRIPT_PROFILING] = sConfig->GetBoolDefault("GScript.Profiling", false);
+
     // Wintergrasp
     m_bool_configs[CONFIG_WINTERGRASP_ENABLE] = sConfig->GetBoolDefault("Wintergrasp.Enable", false);
     m_int_configs[CONFIG_WINTERGRASP_PLAYER_MAX] = sConfig->GetIntDefault("Wintergrasp.PlayerMax", 100);
@@ -1302,6 +1326,8 @@ extern void LoadGameObjectModelList();
 /// Initialize the World
 void World::SetInitialWorldSettings()
 {
+    uint32 startupBegin = getMSTime();
+
     ///- Initialize the random number generator
     srand((unsigned int)time(NULL));
 
@@ -1627,36 +1653,44 @@ void World::SetInitialWorldSettings()
     sLog->outString("Loading channel privileged owners...");
     sObjectMgr->LoadChannelOwnerPrivs();
 
-    // Loot tables
-    LoadLootTables();
-
-    sLog->outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    sLog->outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    sLog->outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
-    sLog->outString("Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    sLog->outString("Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    sLog->outString("Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    sLog->outString("Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    sLog->outString("Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    sLog->outString("Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    ///- Loot, skill, achievement and auction data do not depend on each other, load them in parallel
+    sLog->outString("Loading Loot Tables, Skill Tables, Achievements and Auctions...");
+    StartupLoader loader;
+
+    // Loot tables, reference loot is checked against all the others
+    std::vector<uint32> lootTasks;
+    lootTasks.push_back(loader.Add("Creature Loot Templates", &LoadLootTemplates_Creature));
+    lootTasks.push_back(loader.Add("Fishing Loot Templates", &LoadLootTemplates_Fishing));
+    lootTasks.push_back(loader.Add("Gameobject Loot Templates", &LoadLootTemplates_Gameobject));
+    lootTasks.push_back(loader.Add("Item Loot Templates", &LoadLootTemplates_Item));
+    lootTasks.push_back(loader.Add("Mail Loot Templates", &LoadLootTemplates_Mail));
+    lootTasks.push_back(loader.Add("Milling Loot Templates", &LoadLootTemplates_Milling));
+    lootTasks.push_back(loader.Add("Pickpocketing Loot Templates", &LoadLootTemplates_Pickpocketing));
+    lootTasks.push_back(loader.Add("Skinning Loot Templates", &LoadLootTemplates_Skinning));
+    lootTasks.push_back(loader.Add("Disenchant Loot Templates", &LoadLootTemplates_Disenchant));
+    lootTasks.push_back(loader.Add("Prospecting Loot Templates", &LoadLootTemplates_Prospecting));
+    lootTasks.push_back(loader.Add("Spell Loot Templates", &LoadLootTemplates_Spell));
+    uint32 referenceLoot = loader.Add("Reference Loot Templates", &LoadLootTemplates_Reference);
+    for (std::vector<uint32>::const_iterator itr = lootTasks.begin(); itr != lootTasks.end(); ++itr)
+        loader.AddDependency(referenceLoot, *itr);
+
+    loader.Add("Skill Discovery Table", &LoadSkillDiscoveryTable);
+    loader.Add("Skill Extra Item Table", &LoadSkillExtraItemTable);
+    loader.Add("Skill Fishing Base Levels", []() { sObjectMgr->LoadFishingBaseSkillLevel(); });
+
+    uint32 achievements = loader.Add("Achievements", []() { sAchievementMgr->LoadAchievementReferenceList(); });
+    achievements = loader.Add("Achievement Criteria Lists", []() { sAchievementMgr->LoadAchievementCriteriaList(); }, achievements);
+    achievements = loader.Add("Achievement Criteria Data", []() { sAchievementMgr->LoadAchievementCriteriaData(); }, achievements);
+    achievements = loader.Add("Achievement Rewards", []() { sAchievementMgr->LoadRewards(); }, achievements);
+    achievements = loader.Add("Achievement Reward Locales", []() { sAchievementMgr->LoadRewardLocales(); }, achievements);
+    loader.Add("Completed Achievements", []() { sAchievementMgr->LoadCompletedAchievements(); }, achievements);
 
     ///- Load dynamic data tables from the database
-    sLog->outString("Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
-    sLog->outString("Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
+    uint32 auctionItems = loader.Add("Item Auctions", []() { sAuctionMgr->LoadAuctionItems(); });
+    loader.Add("Auctions", []() { sAuctionMgr->LoadAuctions(); }, auctionItems);
+
+    loader.Run(m_int_configs[CONFIG_STARTUP_LOADER_THREADS]);
+    loader.PrintReport();
 
     sLog->outString("***** GUILDS *****");
     sObjectMgr->LoadGuilds();
@@ -1817,6 +1851,7 @@ void World::SetInitialWorldSettings()
     m_timers[WUPDATE_DELETECHARS].SetInterval(DAY*IN_MILLISECONDS); // check for chars to delete every day
 
     m_timers[WUPDATE_PINGDB].SetInterval(getIntConfig(CONFIG_DB_PING_INTERVAL)*MINUTE*IN_MILLISECONDS);    // Mysql ping time in minutes
+    m_timers[WUPDATE_OPCODESTATS].SetInterval(getIntConfig(CONFIG_OPCODE_STATS_INTERVAL)*IN_MILLISECONDS);
 
     //to set mailtimer to return mails every day between 4 and 5 am
     //mailtimer is increased when updating auctions
@@ -1893,7 +1928,7 @@ void World::SetInitialWorldSettings()
     else
         sLog->SetLogDB(false);
 
-    sLog->outString("WORLD: World initialized");
+    sLog->outString("WORLD: World initialized in %u ms", getMSTimeDiff(startupBegin, getMSTime()));
 
     sLog->outString("SCRIPTS: Initializing scripts");
     sScriptMgr->LoadScriptDatabase();
@@ -2165,6 +2200,13 @@ void World::Update(uint32 diff)
         ScriptDatabase.KeepAlive();
     }
 
+    ///- Append the per opcode packet counters to their CSV file
+    if (m_timers[WUPDATE_OPCODESTATS].Passed())
+    {
+        m_timers[WUPDATE_OPCODESTATS].Reset();
+        sOpcodeStats->DumpCSV();
+    }
+
     // update the instance reset times
     sInstanceSaveMgr->Update();
 
@@ -2188,6 +2230,7 @@ void World::ForceGameEventUpdate()
 /// Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket *packet, WorldSession *self, uint32 team)
 {
+    WorldPacketBroadcast broadcast(packet);
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2362,6 +2405,7 @@ void World::SendGlobalText(const char* text, WorldSession *self)
 /// Send a packet to all players (or players selected team) in the zone (except self if mentioned)
 void World::SendZoneMessage(uint32 zone, WorldPacket *packet, WorldSession *self, uint32 team)
 {
+    WorldPacketBroadcast broadcast(packet);
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -85,6 +85,7 @@ enum WorldTimers
     WUPDATE_MAILBOXQUEUE,
     WUPDATE_DELETECHARS,
     WUPDATE_PINGDB,
+    WUPDATE_OPCODESTATS,
     WUPDATE_COUNT
 };
 
@@ -171,6 +172,9 @@ enum WorldBoolConfigs
     CONFIG_WINTERGRASP_ENABLE,
     CONFIG_RATED_BATTLEGROUND_ENABLED,
     CONFIG_ENABLE_MMAPS,
+    CONFIG_MAP_UPDATE_REGIONS,
+    CONFIG_TERRAIN_MEMORY_MAP,
+    CONFIG_GSCRIPT_PROFILING,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -326,6 +330,8 @@ enum WorldIntConfigs
     CONFIG_RATED_BATTLEGROUND_WEEKS_IN_ROTATION,
     CONFIG_RATED_BATTLEGROUND_MAX_RATING_DIFFERENCE,
     CONFIG_RATED_BATTLEGROUND_RATING_DISCARD_TIMER,
+    CONFIG_STARTUP_LOADER_THREADS,
+    CONFIG_OPCODE_STATS_INTERVAL,
     INT_CONFIG_VALUE_COUNT
 };
 
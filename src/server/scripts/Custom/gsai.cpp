@@ -435,6 +435,11 @@ class GS_CreatureScript : public CreatureScript
             Unit* m_parentUnit = nullptr;
             Unit* m_lastSummonedUnit = nullptr;
 
+            // with GScript.Profiling, commands executed and microseconds spent not yet credited to m_profiledContainer
+            CommandContainer* m_profiledContainer = nullptr;
+            uint32 m_profiledCommands = 0;
+            uint32 m_profiledTime = 0;
+
             GS_ScriptedAI(Creature* cr) : ScriptedAI(cr)
             {
                 com_container = nullptr;
@@ -749,15 +754,15 @@ class GS_CreatureScript : public CreatureScript
 
                 while (com_counter != (uint32)eventItem.end_offset)
                 {
-                    if (eventItem.current_offset == eventItem.start_offset)
-                    {
-                        com_counter = eventItem.start_offset + 1;
-                    }
-
                     // fail safe check (caused by swapping scripts? -> need proper solution)
                     if (!com_container)
                         break;
 
+                    if (eventItem.current_offset == eventItem.start_offset)
+                    {
+                        com_counter = GS_NextCommandOffset(eventItem.start_offset);
+                    }
+
                     ExecuteCommand(0, lock_move_counter, true);
                     eventItem.current_offset = com_counter;
 
@@ -1425,7 +1430,7 @@ class GS_CreatureScript : public CreatureScript
                     if (eventItem.current_offset == eventItem.start_offset)
                     {
                         snapshot_com_counter = com_counter;
-                        com_counter = eventItem.start_offset + 1;
+                        com_counter = GS_NextCommandOffset(eventItem.start_offset);
                     }
 
                     ExecuteCommand(diff, lock_move_counter, true);
@@ -1452,6 +1457,11 @@ class GS_CreatureScript : public CreatureScript
 
             void ExecuteCommand(const uint32 diff, bool &lock_move_counter, bool is_in_event_handler)
             {
+                // the command may replace the script, keep the one to be credited for the time spent
+                bool profiling = sWorld->getBoolConfig(CONFIG_GSCRIPT_PROFILING);
+                CommandContainer* container = com_container;
+                ACE_Time_Value start = profiling ? ACE_OS::gettimeofday() : ACE_Time_Value::zero;
+
                 gs_command* curr = com_container->command_vector[com_counter];
                 Unit* source = GS_SelectUnitTarget(curr->command_delegate);
 
@@ -2127,17 +2137,62 @@ class GS_CreatureScript : public CreatureScript
                 if (!is_waiting && !lock_move_counter && curr->type != GSCR_END_EVENT)
                 {
                     command_incremented = true;
-                    com_counter++;
+                    GS_MoveToNextCommand();
                 }
 
                 // If we are in event hook -> ignore wait condition
                 if (!command_incremented && is_in_event_handler && !lock_move_counter && curr->type != GSCR_END_EVENT)
-                    com_counter++;
+                    GS_MoveToNextCommand();
 
                 // if not explicitly disabled melee attack, and is not waiting or has appropriate flag to attack during waiting,
                 // proceed melee attack
                 if (!disable_melee && (!is_waiting || (wait_flags & GSWF_MELEE_ATTACK)))
                     DoMeleeAttackIfReady();
+
+                if (profiling)
+                {
+                    ACE_Time_Value diffTime = ACE_OS::gettimeofday() - start;
+                    GS_RecordExecution(container, uint32(diffTime.sec() * 1000000 + diffTime.usec()));
+                }
+            }
+
+            // offset of the command following the given one, skipping commands which only mark offsets
+            inline uint32 GS_NextCommandOffset(uint32 offset) const
+            {
+                if (com_container && offset < com_container->next_offset.size())
+                    return com_container->next_offset[offset];
+
+                return offset + 1;
+            }
+
+            // moves counter to the command following the current one
+            inline void GS_MoveToNextCommand()
+            {
+                com_counter = GS_NextCommandOffset(com_counter);
+            }
+
+            // counts locally, the counters shared by all creatures running the script are updated every 64 commands
+            void GS_RecordExecution(CommandContainer* container, uint32 time)
+            {
+                if (container != m_profiledContainer)
+                {
+                    GS_FlushProfile();
+                    m_profiledContainer = container;
+                }
+
+                ++m_profiledCommands;
+                m_profiledTime += time;
+                if (m_profiledCommands >= 64)
+                    GS_FlushProfile();
+            }
+
+            void GS_FlushProfile()
+            {
+                if (m_profiledContainer && m_profiledCommands)
+                    m_profiledContainer->RecordExecution(m_profiledCommands, m_profiledTime);
+
+                m_profiledCommands = 0;
+                m_profiledTime = 0;
             }
         };
 
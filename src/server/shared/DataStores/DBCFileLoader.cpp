@@ -28,10 +28,15 @@
 
 #include "DBCFileLoader.h"
 
+#include <ace/Mem_Map.h>
+
+bool DBCFileLoader::m_mappingEnabled = false;
+
 DBCFileLoader::DBCFileLoader()
 {
     data = NULL;
     fieldsOffset = NULL;
+    mapping = NULL;
 }
 
 bool DBCFileLoader::Load(const char* filename, const char* fmt)
@@ -119,9 +124,73 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
     return true;
 }
 
+bool DBCFileLoader::IsMappable(const char* fmt)
+{
+#if TRINITY_ENDIAN == TRINITY_LITTLEENDIAN
+    // only 4 byte fields stored as they are, strings need pointers and skipped fields are not in the structure
+    for (uint32 x = 0; fmt[x]; ++x)
+        if (fmt[x] != FT_IND && fmt[x] != FT_INT && fmt[x] != FT_FLOAT)
+            return false;
+    return fmt[0] != '\0';
+#else
+    return false;
+#endif
+}
+
+bool DBCFileLoader::Map(const char* filename, const char* fmt)
+{
+    ASSERT(!data && !mapping);
+
+    const uint32 headerSize = 5 * 4;
+
+    mapping = new ACE_Mem_Map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, ACE_MAP_PRIVATE);
+    unsigned char* base = static_cast<unsigned char*>(mapping->addr());
+    size_t size = mapping->size();
+    if (!base || base == MAP_FAILED || size < headerSize)
+    {
+        delete mapping;
+        mapping = NULL;
+        return false;
+    }
+
+    uint32 header[5];
+    memcpy(header, base, headerSize);
+    recordCount = header[1];
+    fieldCount = header[2];
+    recordSize = header[3];
+    stringSize = header[4];
+
+    // 'WDBC', every field 4 bytes wide and nothing missing at the end of the file
+    if (header[0] != 0x43424457 || fieldCount != strlen(fmt) || recordSize != fieldCount * 4 ||
+        size < headerSize + size_t(recordSize) * recordCount + stringSize)
+    {
+        delete mapping;
+        mapping = NULL;
+        return false;
+    }
+
+    fieldsOffset = new uint32[fieldCount];
+    for (uint32 i = 0; i < fieldCount; i++)
+        fieldsOffset[i] = i * 4;
+
+    data = base + headerSize;
+    stringTable = data + recordSize*recordCount;
+    return true;
+}
+
+ACE_Mem_Map* DBCFileLoader::ReleaseMapping()
+{
+    ACE_Mem_Map* released = mapping;
+    mapping = NULL;
+    data = NULL;
+    return released;
+}
+
 DBCFileLoader::~DBCFileLoader()
 {
-    if (data)
+    if (mapping)
+        delete mapping;
+    else if (data)
         delete [] data;
 
     if (fieldsOffset)
@@ -262,6 +331,46 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     return dataTable;
 }
 
+char* DBCFileLoader::AutoProduceIndex(const char* format, uint32& records, char**& indexTable)
+{
+    // same as AutoProduceData, but the records are used where they are
+    typedef char* ptr;
+    if (strlen(format) != fieldCount)
+        return NULL;
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    if (i >= 0)
+    {
+        uint32 maxi = 0;
+        for (uint32 y = 0; y < recordCount; y++)
+        {
+            uint32 ind = getRecord(y).getUInt(i);
+            if (ind > maxi)
+                maxi = ind;
+        }
+
+        ++maxi;
+        records = maxi;
+        indexTable = new ptr[maxi];
+        memset(indexTable, 0, maxi*sizeof(ptr));
+
+        for (uint32 y = 0; y < recordCount; ++y)
+            indexTable[getRecord(y).getUInt(i)] = reinterpret_cast<char*>(data + y*recordSize);
+    }
+    else
+    {
+        records = recordCount;
+        indexTable = new ptr[recordCount];
+
+        for (uint32 y = 0; y < recordCount; ++y)
+            indexTable[y] = reinterpret_cast<char*>(data + y*recordSize);
+    }
+
+    return reinterpret_cast<char*>(data);
+}
+
 char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
 {
     if (strlen(format)!=fieldCount)
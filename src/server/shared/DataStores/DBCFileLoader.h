@@ -26,6 +26,8 @@
 #include "Utilities/ByteConverter.h"
 #include <cassert>
 
+class ACE_Mem_Map;
+
 class DBCFileLoader
 {
     public:
@@ -34,6 +36,16 @@ class DBCFileLoader
 
         bool Load(const char *filename, const char *fmt);
 
+        // Maps the file copy-on-write instead of reading it, only for formats accepted by IsMappable.
+        // Pages stay shared with other processes mapping the same file until a record is written to.
+        bool Map(const char *filename, const char *fmt);
+        ACE_Mem_Map* ReleaseMapping();
+
+        // records of these formats have the same layout in the file and in the structure
+        static bool IsMappable(const char* fmt);
+        static void SetMappingEnabled(bool enabled) { m_mappingEnabled = enabled; }
+        static bool IsMappingEnabled() { return m_mappingEnabled; }
+
         class Record
         {
             public:
@@ -92,6 +104,7 @@ class DBCFileLoader
         bool IsLoaded() const { return data != NULL; }
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char *& sqlDataTable);
         char* AutoProduceStrings(const char* fmt, char* dataTable);
+        char* AutoProduceIndex(const char* fmt, uint32& count, char**& indexTable);
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     private:
 
@@ -102,5 +115,8 @@ class DBCFileLoader
         uint32 *fieldsOffset;
         unsigned char *data;
         unsigned char *stringTable;
+        ACE_Mem_Map *mapping;
+
+        static bool m_mappingEnabled;
 };
 #endif
@@ -31,6 +31,8 @@
 #include "Implementation/WorldDatabase.h"
 #include "DatabaseEnv.h"
 
+#include <ace/Mem_Map.h>
+
 struct SqlDbc
 {
     const std::string * formatString;
@@ -75,7 +77,7 @@ class DBCStorage
 {
     typedef std::list<char*> StringPoolList;
     public:
-        explicit DBCStorage(const char *f) : fmt(f), nCount(0), fieldCount(0), indexTable(NULL), m_dataTable(NULL) { }
+        explicit DBCStorage(const char *f) : fmt(f), nCount(0), fieldCount(0), indexTable(NULL), m_dataTable(NULL), m_mapping(NULL) { }
         ~DBCStorage() { Clear(); }
 
         T const* LookupEntry(uint32 id) const { return (id>=nCount)?NULL:indexTable[id]; }
@@ -87,6 +89,19 @@ class DBCStorage
 
         bool Load(char const* fn, SqlDbc * sql)
         {
+            // records already laid out as T are used straight from the mapped file
+            if (!sql && DBCFileLoader::IsMappingEnabled() && DBCFileLoader::IsMappable(fmt))
+            {
+                DBCFileLoader mapped;
+                if (mapped.Map(fn, fmt))
+                {
+                    fieldCount = mapped.GetCols();
+                    m_dataTable = (T*)mapped.AutoProduceIndex(fmt, nCount, (char**&)indexTable);
+                    m_mapping = mapped.ReleaseMapping();
+                    return indexTable!=NULL;
+                }
+            }
+
             DBCFileLoader dbc;
             // Check if load was sucessful, only then continue
             if (!dbc.Load(fn, fmt))
@@ -263,7 +278,13 @@ class DBCStorage
 
             delete[] ((char*)indexTable);
             indexTable = NULL;
-            delete[] ((char*)m_dataTable);
+            if (m_mapping)
+            {
+                delete m_mapping;
+                m_mapping = NULL;
+            }
+            else
+                delete[] ((char*)m_dataTable);
             m_dataTable = NULL;
 
             while(!m_stringPoolList.empty())
@@ -281,6 +302,7 @@ class DBCStorage
         T** indexTable;
         T* m_dataTable;
         StringPoolList m_stringPoolList;
+        ACE_Mem_Map* m_mapping;                             // set when m_dataTable points into the mapped file
 };
 
 #endif
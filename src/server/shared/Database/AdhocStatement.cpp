@@ -59,3 +59,16 @@ bool BasicStatementTask::Execute()
 
     return m_conn->Execute(m_sql);
 }
+
+// only plain data changes are grouped, statements like TRUNCATE or ALTER would commit the group transaction early
+bool BasicStatementTask::IsGroupable() const
+{
+    if (m_has_result)
+        return false;
+
+    const char* sql = m_sql;
+    while (isspace(*sql))
+        ++sql;
+
+    return !strnicmp(sql, "INSERT", 6) || !strnicmp(sql, "UPDATE", 6) || !strnicmp(sql, "DELETE", 6) || !strnicmp(sql, "REPLACE", 7);
+}
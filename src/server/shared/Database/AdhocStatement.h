@@ -36,6 +36,7 @@ class BasicStatementTask : public SQLOperation
         ~BasicStatementTask();
 
         bool Execute();
+        bool IsGroupable() const;
 
     private:
         const char* m_sql;      //- Raw query to be executed
@@ -26,9 +26,13 @@
 #include "MySQLConnection.h"
 #include "MySQLThreading.h"
 
+#include <ace/OS_NS_sys_time.h>
+#include <vector>
+
 DatabaseWorker::DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con) :
 m_queue(new_queue),
-m_conn(con)
+m_conn(con),
+m_groupCommit(NULL)
 {
     /// Assign thread to task
     activate();
@@ -46,6 +50,14 @@ int DatabaseWorker::svc()
         if (!request)
             break;
 
+        // the group ends with the first operation which can't join it, that one is executed as usual
+        if (m_groupCommit && m_groupCommit->IsEnabled() && request->IsGroupable())
+        {
+            request = ExecuteGroup(request);
+            if (!request)
+                continue;
+        }
+
         request->SetConnection(m_conn);
         request->call();
 
@@ -56,6 +68,103 @@ int DatabaseWorker::svc()
     return 0;
 }
 
+SQLOperation* DatabaseWorker::ExecuteGroup(SQLOperation* first)
+{
+    std::vector<SQLOperation*> group;
+    group.push_back(first);
+
+    // take the writes queued meanwhile, dequeue waits until the absolute deadline at most
+    SQLOperation* next = NULL;
+    ACE_Time_Value deadline = ACE_OS::gettimeofday() + ACE_Time_Value(m_groupCommit->maxDelay / 1000, (m_groupCommit->maxDelay % 1000) * 1000);
+    while (group.size() < m_groupCommit->maxOperations)
+    {
+        ACE_Time_Value timeout = deadline;
+        next = (SQLOperation*)(m_queue->dequeue(&timeout));
+        if (!next || !next->IsGroupable())
+            break;
+
+        group.push_back(next);
+        next = NULL;
+    }
+
+    m_groupCommit->operations += group.size();
+    if (group.size() == 1)
+    {
+        ExecuteAlone(first);
+        return next;
+    }
+
+    m_groupCommit->groups += 1;
+    m_groupCommit->grouped += group.size();
+    if (group.size() > m_groupCommit->largest.value())
+        m_groupCommit->largest = uint32(group.size());
+
+    // A failed write is skipped like outside a group, a failed transaction is rolled back to its savepoint.
+    // A deadlock or a reconnection loses the whole group transaction: the writes before are executed again one by one,
+    // the failed one too after a deadlock. After a reconnection it was already retried on its own.
+    uint32 reconnects = m_conn->GetReconnectCount();
+    uint32 deadlocks = m_conn->GetDeadlockCount();
+    bool aborted = false;
+    size_t lost = 0;                                        // [0, lost) rolled back
+    size_t done = group.size();                             // [done, size) not executed yet
+
+    m_conn->BeginTransaction();
+    for (size_t i = 0; i < group.size(); ++i)
+    {
+        group[i]->SetConnection(m_conn);
+        group[i]->ExecuteInGroup();
+
+        if (m_conn->GetReconnectCount() != reconnects)
+        {
+            aborted = true;
+            lost = i;
+            done = i + 1;
+            break;
+        }
+        if (m_conn->GetDeadlockCount() != deadlocks)
+        {
+            m_conn->RollbackTransaction();
+            aborted = true;
+            lost = done = i + 1;
+            break;
+        }
+    }
+
+    if (!aborted)
+    {
+        m_conn->CommitTransaction();
+        if (m_conn->GetReconnectCount() != reconnects)
+        {
+            aborted = true;
+            lost = group.size();
+        }
+    }
+
+    if (aborted)
+    {
+        sLog->outSQLDriver("[Warning] Group commit of %u operations lost its transaction, executing %u of them again one by one.",
+            uint32(group.size()), uint32(lost + group.size() - done));
+        m_groupCommit->retried += 1;
+    }
+
+    for (size_t i = 0; i < group.size(); ++i)
+    {
+        if (i < lost || i >= done)
+            ExecuteAlone(group[i]);
+        else
+            delete group[i];
+    }
+
+    return next;
+}
+
+void DatabaseWorker::ExecuteAlone(SQLOperation* op)
+{
+    op->SetConnection(m_conn);
+    op->call();
+    delete op;
+}
+
 int DatabaseWorker::activate()
 {
     /* THR_DETACHED:
@@ -25,8 +25,31 @@
 
 #include <ace/Task.h>
 #include <ace/Activation_Queue.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+
+#include "Define.h"
 
 class MySQLConnection;
+class SQLOperation;
+
+//! Group commit settings of a pool and the counters of its async workers.
+//! With group commit enabled a worker executes the one-way writes waiting in the queue in a single transaction.
+struct DatabaseGroupCommit
+{
+    DatabaseGroupCommit() : maxOperations(0), maxDelay(0), operations(0), groups(0), grouped(0), retried(0), largest(0) {}
+
+    bool IsEnabled() const { return maxOperations > 1; }
+
+    uint32 maxOperations;                                   //! writes committed together at most, 0 or 1 disables grouping
+    uint32 maxDelay;                                        //! ms a worker waits for more writes once it has one
+
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint64> operations;     //! writes executed by the workers
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint64> groups;         //! commits of more than one write
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint64> grouped;        //! writes committed in those
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint64> retried;        //! groups executed again one by one after losing their transaction
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint32> largest;        //! largest group, approximate
+};
 
 class DatabaseWorker : public ACE_Task_Base
 {
@@ -38,10 +61,18 @@ class DatabaseWorker : public ACE_Task_Base
         int activate();
         int wait() { return ACE_Task_Base::wait(); }
 
+        //! Must be set before operations are queued, the settings are shared by all workers of the pool
+        void SetGroupCommit(DatabaseGroupCommit* groupCommit) { m_groupCommit = groupCommit; }
+
     private:
         DatabaseWorker() : ACE_Task_Base() {}
+
+        SQLOperation* ExecuteGroup(SQLOperation* first);
+        void ExecuteAlone(SQLOperation* op);
+
         ACE_Activation_Queue* m_queue;
         MySQLConnection* m_conn;
+        DatabaseGroupCommit* m_groupCommit;
 };
 
 #endif
@@ -85,6 +85,7 @@ class DatabaseWorkerPool
             {
                 T* t = new T(m_queue, m_connectionInfo);
                 t->Open();
+                t->m_worker->SetGroupCommit(&m_groupCommit);
                 m_connections[IDX_ASYNC][i] = t;
                 ++m_connectionCount[IDX_ASYNC];
             }
@@ -100,9 +101,24 @@ class DatabaseWorkerPool
             }
 
             sLog->outSQLDriver("Databasepool opened succesfuly. %u total connections running.", (m_connectionCount[IDX_SYNCH] + m_connectionCount[IDX_ASYNC]));
+            if (m_groupCommit.IsEnabled())
+                sLog->outSQLDriver("Group commit of up to %u writes, waiting up to %u ms for more.", m_groupCommit.maxOperations, m_groupCommit.maxDelay);
             return true;
         }
 
+        //! Lets the async workers commit up to maxOperations queued writes in one transaction, waiting up to maxDelay ms
+        //! for more writes once they have one. Must be called before Open().
+        void SetGroupCommit(uint32 maxOperations, uint32 maxDelay)
+        {
+            m_groupCommit.maxOperations = maxOperations;
+            m_groupCommit.maxDelay = maxDelay;
+        }
+
+        DatabaseGroupCommit const& GetGroupCommit() const { return m_groupCommit; }
+
+        //! Operations waiting for an async worker
+        size_t GetQueueSize() const { return m_queue->method_count(); }
+
         void Close()
         {
             sLog->outSQLDriver("Closing down databasepool '%s'.", m_connectionInfo.database.c_str());
@@ -340,21 +356,16 @@ class DatabaseWorkerPool
         //! were appended to the transaction will be respected during execution.
         void CommitTransaction(SQLTransaction transaction)
         {
-            if (sLog->GetSQLDriverQueryLogging())
+            if (!transaction->GetSize())
             {
-                switch (transaction->GetSize())
-                {
-                    case 0:
-                        sLog->outSQLDriver("Transaction contains 0 queries. Not executing.");
-                        return;
-                    case 1:
-                        sLog->outSQLDriver("Warning: Transaction only holds 1 query, consider removing Transaction context in code.");
-                        break;
-                    default:
-                        break;
-                }
+                if (sLog->GetSQLDriverQueryLogging())
+                    sLog->outSQLDriver("Transaction contains 0 queries. Not executing.");
+                return;
             }
 
+            if (sLog->GetSQLDriverQueryLogging() && transaction->GetSize() == 1)
+                sLog->outSQLDriver("Warning: Transaction only holds 1 query, consider removing Transaction context in code.");
+
             Enqueue(new TransactionTask(transaction));
         }
 
@@ -463,6 +474,7 @@ class DatabaseWorkerPool
         };
 
         ACE_Activation_Queue*           m_queue;             //! Queue shared by async worker threads.
+        DatabaseGroupCommit             m_groupCommit;       //! Group commit settings and counters of the async workers.
         std::vector< std::vector<T*> >  m_connections;
         uint32                          m_connectionCount[2];       //! Counter of MySQL connections;
         MySQLConnectionInfo             m_connectionInfo;
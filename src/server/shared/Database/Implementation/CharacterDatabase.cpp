@@ -273,6 +273,7 @@ bool CharacterDatabaseConnection::Open()
 
     // Auras
     PrepareStatement(CHAR_DEL_AURA, "DELETE FROM character_aura WHERE guid = ?", true);
+    PrepareStatement(CHAR_DEL_AURA_BY_SPELL, "DELETE FROM character_aura WHERE guid = ? AND caster_guid = ? AND spell = ? AND effect_mask = ?", true);
     PrepareStatement(CHAR_ADD_AURA, "INSERT INTO character_aura (guid,caster_guid,spell,effect_mask,recalculate_mask,stackcount,amount0,amount1,amount2,base_amount0,base_amount1,base_amount2,maxduration,remaintime,remaincharges) "
             "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", true);
 
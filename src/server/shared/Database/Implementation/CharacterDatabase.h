@@ -218,6 +218,7 @@ enum CharacterDatabaseStatements
     CHAR_DEL_EQUIP_SET,
 
     CHAR_DEL_AURA,
+    CHAR_DEL_AURA_BY_SPELL,
     CHAR_ADD_AURA,
 
     CHAR_LOAD_PLAYER_CURRENCY,
@@ -43,7 +43,9 @@ m_queue(NULL),
 m_worker(NULL),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_SYNCH)
+m_connectionFlags(CONNECTION_SYNCH),
+m_reconnects(0),
+m_deadlocks(0)
 {
 }
 
@@ -52,7 +54,9 @@ m_reconnecting(false),
 m_queue(queue),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_ASYNC)
+m_connectionFlags(CONNECTION_ASYNC),
+m_reconnects(0),
+m_deadlocks(0)
 {
     m_worker = new DatabaseWorker(m_queue, this);
 }
@@ -457,6 +461,7 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo)
                             (m_connectionFlags & CONNECTION_ASYNC) ? "asynchronous" : "synchronous");
 
                 m_reconnecting = false;
+                ++m_reconnects;
                 return true;
             }
 
@@ -465,6 +470,10 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo)
             return _HandleMySQLErrno(lErrno);           // Call self (recursive)
         }
 
+        case 1213:      // "Deadlock found when trying to get lock; try restarting transaction"
+            ++m_deadlocks;
+            return false;
+
         // Query related errors - skip query
         case 1058:      // "Column count doesn't match value count"
         case 1062:      // "Duplicate entry '%s' for key '%d'"
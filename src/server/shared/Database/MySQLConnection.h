@@ -93,6 +93,10 @@ class MySQLConnection
         operator bool () const { return m_Mysql != NULL; }
         void Ping() { mysql_ping(m_Mysql); }
 
+        //! Both lose the open transaction, a group commit compares them before and after each operation
+        uint32 GetReconnectCount() const { return m_reconnects; }
+        uint32 GetDeadlockCount() const { return m_deadlocks; }
+
     protected:
         bool LockIfReady()
         {
@@ -125,6 +129,8 @@ class MySQLConnection
         MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
         ConnectionFlags       m_connectionFlags;            //! Connection flags (for preparing relevant statements)
         ACE_Thread_Mutex      m_Mutex;
+        uint32                m_reconnects;                 //! Successful reconnections.
+        uint32                m_deadlocks;                  //! Transactions rolled back by the server to resolve a deadlock.
 };
 
 #endif
@@ -155,6 +155,7 @@ class PreparedStatementTask : public SQLOperation
         ~PreparedStatementTask();
 
         bool Execute();
+        bool IsGroupable() const { return !m_has_result; }
 
     protected:
         PreparedStatement* m_stmt;
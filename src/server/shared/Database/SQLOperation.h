@@ -73,6 +73,11 @@ class SQLOperation : public ACE_Method_Request
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //- One-way writes which may share a transaction with other ones, see DatabaseGroupCommit.
+        //- They must be able to execute again if the group transaction is lost.
+        virtual bool IsGroupable() const { return false; }
+        virtual bool ExecuteInGroup() { return Execute(); }
+
         MySQLConnection* m_conn;
 };
 
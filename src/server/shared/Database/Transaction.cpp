@@ -70,13 +70,30 @@ void Transaction::Cleanup()
     }
 }
 
+ACE_Atomic_Op<ACE_Thread_Mutex, uint32> TransactionTask::m_failedCount;
+
 bool TransactionTask::Execute()
 {
-    std::queue<SQLElementData> &queries = m_trans->m_queries;
+    return _Execute(false);
+}
+
+bool TransactionTask::ExecuteInGroup()
+{
+    return _Execute(true);
+}
+
+bool TransactionTask::_Execute(bool grouped)
+{
+    // the statements are freed with the transaction, a group commit may have to execute them again
+    std::queue<SQLElementData> queries = m_trans->m_queries;
     if (queries.empty())
         return false;
 
-    m_conn->BeginTransaction();
+    if (grouped)
+        m_conn->Execute("SAVEPOINT group_transaction");
+    else
+        m_conn->BeginTransaction();
+
     while (!queries.empty())
     {
         SQLElementData data = queries.front();
@@ -89,10 +106,13 @@ bool TransactionTask::Execute()
                 if (!m_conn->Execute(stmt))
                 {
                     sLog->outSQLDriver("[Warning] Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    m_conn->RollbackTransaction();
+                    ++m_failedCount;
+                    if (grouped)
+                        m_conn->Execute("ROLLBACK TO SAVEPOINT group_transaction");
+                    else
+                        m_conn->RollbackTransaction();
                     return false;
                 }
-                delete data.element.stmt;
             }
             break;
             case SQL_ELEMENT_RAW:
@@ -102,15 +122,20 @@ bool TransactionTask::Execute()
                 if (!m_conn->Execute(sql))
                 {
                     sLog->outSQLDriver("[Warning] Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    m_conn->RollbackTransaction();
+                    ++m_failedCount;
+                    if (grouped)
+                        m_conn->Execute("ROLLBACK TO SAVEPOINT group_transaction");
+                    else
+                        m_conn->RollbackTransaction();
                     return false;
                 }
-                free((void*)const_cast<char*>(sql));
             }
             break;
         }
         queries.pop();
     }
-    m_conn->CommitTransaction();
+
+    if (!grouped)
+        m_conn->CommitTransaction();
     return true;
 }
@@ -24,6 +24,7 @@
 #define _TRANSACTION_H
 
 #include "SQLOperation.h"
+#include <ace/Atomic_Op.h>
 
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
@@ -59,10 +60,21 @@ class TransactionTask : public SQLOperation
         TransactionTask(SQLTransaction trans) : m_trans(trans) {} ;
         ~TransactionTask(){};
 
+        bool IsGroupable() const { return true; }
+
+        //- Transactions aborted and rolled back since startup, in all databases
+        static uint32 GetFailedCount() { return m_failedCount.value(); }
+
     protected:
         bool Execute();
+        bool ExecuteInGroup();          //- within the group transaction, rolled back to a savepoint on failure
+
+    private:
+        bool _Execute(bool grouped);
 
         SQLTransaction m_trans;
+
+        static ACE_Atomic_Op<ACE_Thread_Mutex, uint32> m_failedCount;
 };
 
 #endif
\ No newline at end of file
@@ -394,6 +394,8 @@ bool Master::_StartDB()
     }
 
     synch_threads = sConfig->GetIntDefault("WorldDatabase.SynchThreads", 1);
+    WorldDatabase.SetGroupCommit(sConfig->GetIntDefault("WorldDatabase.GroupCommitSize", 0),
+        sConfig->GetIntDefault("WorldDatabase.GroupCommitDelay", 0));
     ///- Initialise the world database
     if (!WorldDatabase.Open(dbstring, async_threads, synch_threads))
     {
@@ -425,6 +427,8 @@ bool Master::_StartDB()
     }
 
     synch_threads = sConfig->GetIntDefault("CharacterDatabase.SynchThreads", 2);
+    CharacterDatabase.SetGroupCommit(sConfig->GetIntDefault("CharacterDatabase.GroupCommitSize", 0),
+        sConfig->GetIntDefault("CharacterDatabase.GroupCommitDelay", 0));
 
     ///- Initialise the Character database
     if (!CharacterDatabase.Open(dbstring, async_threads, synch_threads))
@@ -450,6 +454,8 @@ bool Master::_StartDB()
     }
 
     synch_threads = sConfig->GetIntDefault("LoginDatabase.SynchThreads", 1);
+    LoginDatabase.SetGroupCommit(sConfig->GetIntDefault("LoginDatabase.GroupCommitSize", 0),
+        sConfig->GetIntDefault("LoginDatabase.GroupCommitDelay", 0));
     ///- Initialise the login database
     if (!LoginDatabase.Open(dbstring, async_threads, synch_threads))
     {